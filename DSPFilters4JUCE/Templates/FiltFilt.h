@@ -0,0 +1,450 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_FILTFILT_H
+#define DSPFILTERS_FILTFILT_H
+
+/*
+ * Zero phase forward-backward filtering (filtfilt)
+ *
+ * Runs a cascade of second order sections over the signal once forward
+ * and once backward. The phase responses cancel out and the magnitude
+ * response gets squared, so a 4th order Butterworth turns into an 8th
+ * order zero phase filter with -6 dB at the cutoff.
+ *
+ * Like scipy's sosfiltfilt, both ends of the signal are padded with an
+ * odd extension (2*x[0] - x[n]) and every section starts in the steady
+ * state that matches the first padded sample. That keeps the start and
+ * end transients out of the result.
+ *
+ * Offline processes a whole signal in place. It only ever keeps
+ * padLength samples on the side, no copy or reversed copy of the signal.
+ *
+ * Streaming filters endless signals in chunks with bounded memory. The
+ * backward pass runs over overlapping segments: every blockLength samples
+ * it starts overlap samples in the future, by which time the error of the
+ * guessed start state has decayed below the noise floor. The output is
+ * delayed by blockLength + overlap samples, call flush() at the end.
+ *
+ * The engines keep their own copy of the coefficients, so the cascade
+ * they were set up from is free to keep filtering in real time.
+ *
+ */
+
+namespace FiltFilt
+{
+    // Coefficients and states shared by both engines
+    template <int MaxStages, class StateType = DEFAULT_STATE>
+    class Stages
+    {
+    public:
+        Stages () : m_numStages (0) {}
+        
+        void setup (const Biquad* stages, int numStages)
+        {
+            assert (numStages >= 0 && numStages <= MaxStages);
+            
+            m_numStages = numStages;
+            for (int i = 0; i < numStages; ++i)
+                m_stages[i] = stages[i];
+            
+            reset ();
+        }
+        
+        void setup (Cascade& cascade)
+        {
+            assert (cascade.getNumStages () <= MaxStages);
+            
+            m_numStages = cascade.getNumStages ();
+            for (int i = 0; i < m_numStages; ++i)
+                m_stages[i] = cascade[i];
+            
+            reset ();
+        }
+        
+        int getNumStages () const
+        {
+            return m_numStages;
+        }
+        
+        // Same default as scipy, three times the number of coefficients
+        int getDefaultPadLength () const
+        {
+            return 3 * (2 * m_numStages + 1);
+        }
+        
+        // Samples until the slowest pole has decayed by the given amount
+        int getDecayLength (double dB = 150) const
+        {
+            double radius = 0;
+            for (int i = 0; i < m_numStages; ++i)
+            {
+                const double a1 = m_stages[i].m_a1;
+                const double a2 = m_stages[i].m_a2;
+                const double d = a1 * a1 - 4 * a2;
+                
+                if (d < 0)
+                    radius = std::max (radius, sqrt (a2));
+                else
+                    radius = std::max (radius, (fabs (a1) + sqrt (d)) / 2);
+            }
+            
+            const int maxLength = 1 << 22;
+            if (radius >= 1)
+                return maxLength;
+            if (radius <= 0)
+                return 1;
+            
+            const double length = ceil (-dB / (20 * log10 (radius)));
+            return static_cast<int> (std::min (length, double (maxLength)));
+        }
+        
+        void reset ()
+        {
+            for (int i = 0; i < MaxStages; ++i)
+            {
+                m_forwardStates[i].reset ();
+                m_backwardStates[i].reset ();
+            }
+        }
+        
+    protected:
+        // Puts all sections into the steady state for a constant input
+        void prime (StateType* states, double in)
+        {
+            for (int i = 0; i < m_numStages; ++i)
+                in = states[i].setSteadyState (in, m_stages[i]);
+        }
+        
+        inline double filter (StateType* states, double in)
+        {
+            for (int i = 0; i < m_numStages; ++i)
+                in = states[i].process1 (in, m_stages[i]);
+            return in;
+        }
+        
+        // The passes need their own states, in the Streaming
+        // engine they take turns without finishing in between.
+        StateType m_forwardStates[MaxStages];
+        StateType m_backwardStates[MaxStages];
+        
+    private:
+        int m_numStages;
+        Biquad m_stages[MaxStages];
+    };
+    
+    //--------------------------------------------------------------------------
+    
+    template <int MaxStages, class StateType = DEFAULT_STATE>
+    class Offline : public Stages<MaxStages, StateType>
+    {
+    public:
+        Offline () : m_padLength (-1) {}
+        
+        // Pass -1 to go back to getDefaultPadLength()
+        void setPadLength (int samples)
+        {
+            m_padLength = samples;
+        }
+        
+        int getPadLength () const
+        {
+            return (m_padLength < 0) ? this->getDefaultPadLength () : m_padLength;
+        }
+        
+        template <typename Sample>
+        void process (int numSamples, Sample* dest)
+        {
+            if (numSamples < 1)
+                return;
+            
+            const int pad = std::min (getPadLength (), numSamples - 1);
+            const double first = dest[0];
+            const double last = dest[numSamples - 1];
+            
+            // The right extension mirrors samples the forward
+            // pass is about to overwrite, keep those aside.
+            m_edge.resize (pad);
+            for (int k = 1; k <= pad; ++k)
+                m_edge[k - 1] = dest[numSamples - 1 - k];
+            
+            // forward, the left extension only warms up the states
+            this->prime (this->m_forwardStates, 2 * first - dest[pad]);
+            for (int k = pad; k >= 1; --k)
+                this->filter (this->m_forwardStates, 2 * first - dest[k]);
+            
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = static_cast<Sample> (this->filter (this->m_forwardStates, dest[i]));
+            
+            for (int k = 1; k <= pad; ++k)
+                m_edge[k - 1] = this->filter (this->m_forwardStates, 2 * last - m_edge[k - 1]);
+            
+            // backward, starting at the end of the right extension
+            this->prime (this->m_backwardStates, (pad > 0) ? m_edge[pad - 1] : dest[numSamples - 1]);
+            for (int k = pad; k >= 1; --k)
+                this->filter (this->m_backwardStates, m_edge[k - 1]);
+            
+            for (int i = numSamples; --i >= 0;)
+                dest[i] = static_cast<Sample> (this->filter (this->m_backwardStates, dest[i]));
+        }
+        
+    private:
+        int m_padLength;
+        std::vector<double> m_edge;
+    };
+    
+    //--------------------------------------------------------------------------
+    
+    template <int MaxStages, class StateType = DEFAULT_STATE>
+    class Streaming : public Stages<MaxStages, StateType>
+    {
+    public:
+        Streaming ()
+        : m_blockLength (0)
+        , m_overlap (0)
+        , m_padLength (0)
+        , m_usedPad (0)
+        , m_started (false)
+        , m_numInputs (0)
+        , m_fill (0)
+        , m_outRead (0)
+        , m_outAvail (0)
+        , m_pending (0)
+        {
+        }
+        
+        // Call after setup(). Pass -1 for the overlap to have it follow the
+        // decay of the slowest pole, -1 for the pad length to use the default.
+        void prepare (int blockLength, int overlap = -1, int padLength = -1)
+        {
+            assert (blockLength > 0);
+            
+            m_blockLength = blockLength;
+            m_overlap = (overlap < 0) ? this->getDecayLength () : overlap;
+            m_padLength = (padLength < 0) ? this->getDefaultPadLength () : padLength;
+            
+            // the left edge has to be in before the first block is due
+            assert (m_padLength < m_blockLength + m_overlap);
+            
+            m_head.reserve (m_padLength + 1);
+            m_recent.resize (m_padLength + 1);
+            m_forward.resize (m_blockLength + m_overlap + m_padLength);
+            m_output.resize (m_blockLength);
+            
+            reset ();
+        }
+        
+        // Output delay in samples
+        int getLatency () const
+        {
+            return m_blockLength + m_overlap;
+        }
+        
+        void reset ()
+        {
+            Stages<MaxStages, StateType>::reset ();
+            
+            m_head.clear ();
+            m_started = false;
+            m_numInputs = 0;
+            m_fill = 0;
+            m_outRead = 0;
+            m_outAvail = 0;
+            m_pending = getLatency ();
+        }
+        
+        // Filters in place, delayed by getLatency() samples
+        template <typename Sample>
+        void process (int numSamples, Sample* dest)
+        {
+            assert (m_blockLength > 0);
+            
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const double in = dest[i];
+                dest[i] = static_cast<Sample> (pop ());
+                push (in);
+            }
+        }
+        
+        // Finishes the signal with the right edge and writes out whatever
+        // is still in the pipeline, up to getLatency() samples. Returns the
+        // number of samples written, the engine is reset afterwards.
+        template <typename Sample>
+        int flush (Sample* dest)
+        {
+            if (m_numInputs == 0)
+                return 0;
+            
+            if (! m_started)
+                start (static_cast<int> (m_head.size ()) - 1);
+            
+            int written = 0;
+            while (m_outRead < m_outAvail)
+                dest[written++] = static_cast<Sample> (m_output[m_outRead++]);
+            
+            const int pad = m_usedPad;
+            const double last = recent (0);
+            for (int k = 1; k <= pad; ++k)
+                m_forward[m_fill++] = this->filter (this->m_forwardStates, 2 * last - recent (k));
+            
+            // whatever is left gets the exact treatment of the Offline engine
+            if (m_fill > 0)
+            {
+                this->prime (this->m_backwardStates, m_forward[m_fill - 1]);
+                for (int i = m_fill; --i >= 0;)
+                    m_forward[i] = this->filter (this->m_backwardStates, m_forward[i]);
+            }
+            
+            for (int i = 0; i < m_fill - pad; ++i)
+                dest[written++] = static_cast<Sample> (m_forward[i]);
+            
+            reset ();
+            
+            return written;
+        }
+        
+    private:
+        // input sample k steps back, 0 being the newest
+        double recent (int k) const
+        {
+            const long long size = static_cast<long long> (m_recent.size ());
+            return m_recent[static_cast<size_t> ((m_numInputs - 1 - k + size) % size)];
+        }
+        
+        double pop ()
+        {
+            if (m_pending > 0)
+            {
+                --m_pending;
+                return 0;
+            }
+            
+            assert (m_outRead < m_outAvail);
+            return m_output[m_outRead++];
+        }
+        
+        void push (double in)
+        {
+            m_recent[static_cast<size_t> (m_numInputs % static_cast<long long> (m_recent.size ()))] = in;
+            ++m_numInputs;
+            
+            if (m_started)
+            {
+                forward (in);
+            }
+            else
+            {
+                m_head.push_back (in);
+                if (static_cast<int> (m_head.size ()) == m_padLength + 1)
+                    start (m_padLength);
+            }
+        }
+        
+        // Runs the left edge, then everything collected so far
+        void start (int pad)
+        {
+            const double first = m_head[0];
+            
+            this->prime (this->m_forwardStates, 2 * first - m_head[pad]);
+            for (int k = pad; k >= 1; --k)
+                this->filter (this->m_forwardStates, 2 * first - m_head[k]);
+            
+            m_usedPad = pad;
+            m_started = true;
+            
+            for (size_t i = 0; i < m_head.size (); ++i)
+                forward (m_head[i]);
+            
+            m_head.clear ();
+        }
+        
+        void forward (double in)
+        {
+            m_forward[m_fill++] = this->filter (this->m_forwardStates, in);
+            
+            if (m_fill == m_blockLength + m_overlap)
+                backward ();
+        }
+        
+        // Backward pass over one block plus its overlap, the
+        // overlap is only there for the states to settle.
+        void backward ()
+        {
+            assert (m_outRead == m_outAvail);
+            
+            const int length = m_blockLength + m_overlap;
+            
+            this->prime (this->m_backwardStates, m_forward[length - 1]);
+            for (int i = length; --i >= m_blockLength;)
+                this->filter (this->m_backwardStates, m_forward[i]);
+            
+            for (int i = m_blockLength; --i >= 0;)
+                m_output[i] = this->filter (this->m_backwardStates, m_forward[i]);
+            
+            std::copy (m_forward.begin () + m_blockLength,
+                       m_forward.begin () + length,
+                       m_forward.begin ());
+            
+            m_fill = m_overlap;
+            m_outRead = 0;
+            m_outAvail = m_blockLength;
+        }
+        
+        int m_blockLength;
+        int m_overlap;
+        int m_padLength;
+        int m_usedPad;
+        bool m_started;
+        long long m_numInputs;
+        int m_fill;
+        int m_outRead;
+        int m_outAvail;
+        int m_pending;
+        std::vector<double> m_head;
+        std::vector<double> m_recent;
+        std::vector<double> m_forward;
+        std::vector<double> m_output;
+    };
+}
+
+#endif
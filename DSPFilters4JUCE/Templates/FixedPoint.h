@@ -0,0 +1,545 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_FIXEDPOINT_H
+#define DSPFILTERS_FIXEDPOINT_H
+
+/*
+ * Fixed point cascade for integer pipelines
+ *
+ * Runs a cascade on Q31 samples, full scale is +-2^31, so 24 bit PCM
+ * shifted up by 8 bits goes straight in and out without converting to
+ * float and back. The stages run in Direct Form I: samples and states are
+ * 32 bit, and all five products of a stage sum up in a 64 bit accumulator
+ * before the one rounding of the stage. Each stage's coefficients get as
+ * many fraction bits as they can (30 at most) while the accumulator
+ * provably can't overflow. Stage outputs saturate at full scale, so the
+ * stages should be peak scaled, see Cascade::setStageOptimization().
+ *
+ * With ErrorOrder 1 or 2 the rounding error is fed back into the next
+ * accumulation, the same noise shaping as ErrorFeedbackDirectFormI in
+ * State.h, which moves the noise away from DC where low cutoffs boost it.
+ * Order 0 simply rounds.
+ *
+ * Up to eight channels run side by side, in two AVX2 registers (32x32 to
+ * 64 bit multiplies) or four NEON registers, whichever getSimdLevel()
+ * picks, with the same results bit for bit as the scalar code. Two
+ * independent recursions hide each other's latency, so eight channels
+ * take hardly longer than four.
+ *
+ * getCoefficientError() and getResponseError() tell how much quantizing
+ * the coefficients changed the filter.
+ *
+ */
+
+namespace FixedPoint
+{
+    template <int MaxStages, int MaxChannels, int ErrorOrder = 1>
+    class Stages
+    {
+    public:
+        enum
+        {
+            Lanes = (MaxChannels + 7) & ~7,
+            TileLanes = 8,
+            TileFrames = 64
+        };
+        
+        Stages ()
+        : m_numStages (0)
+        , m_processStage (&processStageScalar)
+        {
+            reset ();
+        }
+        
+        // Quantizes the coefficients. Keeps the states.
+        void setup (const Biquad* stages, int numStages)
+        {
+            assert (numStages >= 0 && numStages <= MaxStages);
+            
+            m_processStage = selectStage (getSimdLevel ());
+            m_numStages = numStages;
+            
+            for (int i = 0; i < numStages; ++i)
+            {
+                m_source[i] = stages[i];
+                quantize (stages[i], m_coefficients[i]);
+            }
+        }
+        
+        void setup (::DSP::Templates::Cascade& cascade)
+        {
+            Biquad stages[MaxStages];
+            for (int i = 0; i < cascade.getNumStages (); ++i)
+                stages[i] = cascade[i];
+            
+            setup (stages, cascade.getNumStages ());
+        }
+        
+        void reset ()
+        {
+            for (int i = 0; i < MaxStages; ++i)
+            {
+                StageState& s = m_states[i];
+                for (int lane = 0; lane < Lanes; ++lane)
+                {
+                    s.x1[lane] = s.x2[lane] = s.y1[lane] = s.y2[lane] = 0;
+                    s.e1[lane] = s.e2[lane] = 0;
+                }
+            }
+        }
+        
+        // Largest difference between a coefficient and its quantized value
+        double getCoefficientError () const
+        {
+            double error = 0;
+            for (int i = 0; i < m_numStages; ++i)
+            {
+                double exact[5];
+                double quantized[5];
+                getCoefficients (m_source[i], exact);
+                getCoefficients (m_coefficients[i], quantized);
+                
+                for (int j = 0; j < 5; ++j)
+                    error = std::max (error, std::abs (quantized[j] - exact[j]));
+            }
+            return error;
+        }
+        
+        // Largest difference of the quantized frequency response from the
+        // exact one, relative to the exact response's peak
+        double getResponseError (int numPoints = 512) const
+        {
+            double peak = 0;
+            double error = 0;
+            for (int i = 0; i < numPoints; ++i)
+            {
+                const double w = doublePi * i / (numPoints - 1);
+                complex_t exact (1);
+                complex_t quantized (1);
+                
+                for (int k = 0; k < m_numStages; ++k)
+                {
+                    double c[5];
+                    getCoefficients (m_source[k], c);
+                    exact *= getResponse (c, w);
+                    getCoefficients (m_coefficients[k], c);
+                    quantized *= getResponse (c, w);
+                }
+                
+                peak = std::max (peak, std::abs (exact));
+                error = std::max (error, std::abs (quantized - exact));
+            }
+            return (peak > 0) ? error / peak : 0;
+        }
+        
+        // In place, one array of Q31 samples per channel
+        void process (int numSamples, int32_t* const* channels, int numChannels)
+        {
+            assert (numChannels >= 0 && numChannels <= MaxChannels);
+            
+            for (int offset = 0; offset < numChannels; offset += TileLanes)
+            {
+                const int width = std::min (static_cast<int> (TileLanes), numChannels - offset);
+                
+                for (int start = 0; start < numSamples; start += TileFrames)
+                {
+                    const int length = std::min (static_cast<int> (TileFrames), numSamples - start);
+                    
+                    for (int i = 0; i < length; ++i)
+                        for (int lane = 0; lane < TileLanes; ++lane)
+                            m_tile[i * TileLanes + lane] = (lane < width) ? channels[offset + lane][start + i] : 0;
+                    
+                    for (int stage = 0; stage < m_numStages; ++stage)
+                        m_processStage (m_coefficients[stage], m_states[stage], m_tile, length, offset, width);
+                    
+                    for (int i = 0; i < length; ++i)
+                        for (int lane = 0; lane < width; ++lane)
+                            channels[offset + lane][start + i] = m_tile[i * TileLanes + lane];
+                }
+            }
+        }
+        
+        // Interleaved integer PCM, see Pcm.h. dest may be src. The frames
+        // go through a tile at a time, all channels of a tile before the
+        // next, and are converted on their way into and out of the tile.
+        template <class Format>
+        void processInterleaved (int numFrames, const void* src, void* dest, int numChannels)
+        {
+            assert (numChannels >= 0 && numChannels <= MaxChannels);
+            
+            const int frameBytes = numChannels * Format::bytesPerSample;
+            const unsigned char* in = static_cast<const unsigned char*> (src);
+            unsigned char* out = static_cast<unsigned char*> (dest);
+            
+            for (int start = 0; start < numFrames; start += TileFrames)
+            {
+                const int length = std::min (static_cast<int> (TileFrames), numFrames - start);
+                
+                for (int offset = 0; offset < numChannels; offset += TileLanes)
+                {
+                    const int width = std::min (static_cast<int> (TileLanes), numChannels - offset);
+                    
+                    const unsigned char* p = in + start * frameBytes + offset * Format::bytesPerSample;
+                    for (int i = 0; i < length; ++i, p += frameBytes)
+                        for (int lane = 0; lane < TileLanes; ++lane)
+                            m_tile[i * TileLanes + lane] = (lane < width) ?
+                                Format::readQ31 (p + lane * Format::bytesPerSample) : 0;
+                    
+                    for (int stage = 0; stage < m_numStages; ++stage)
+                        m_processStage (m_coefficients[stage], m_states[stage], m_tile, length, offset, width);
+                    
+                    unsigned char* q = out + start * frameBytes + offset * Format::bytesPerSample;
+                    for (int i = 0; i < length; ++i, q += frameBytes)
+                        for (int lane = 0; lane < width; ++lane)
+                            Format::writeQ31 (q + lane * Format::bytesPerSample, m_tile[i * TileLanes + lane]);
+                }
+            }
+        }
+        
+    private:
+        // b0, b1, b2 and the negated a1, a2, in units of 2^-shift
+        struct Coefficients
+        {
+            int32_t b0, b1, b2, a1, a2;
+            int shift;
+        };
+        
+        struct StageState
+        {
+            int32_t x1[Lanes], x2[Lanes], y1[Lanes], y2[Lanes];
+            int64_t e1[Lanes], e2[Lanes];    // rounding errors, in accumulator units
+        };
+        
+        typedef void (*StageFunction) (const Coefficients&, StageState&, int32_t*, int, int, int);
+        
+        static void getCoefficients (const BiquadBase& s, double* c)
+        {
+            c[0] = s.m_b0;
+            c[1] = s.m_b1;
+            c[2] = s.m_b2;
+            c[3] = -s.m_a1;
+            c[4] = -s.m_a2;
+        }
+        
+        static void getCoefficients (const Coefficients& q, double* c)
+        {
+            const double scale = std::ldexp (1., -q.shift);
+            c[0] = q.b0 * scale;
+            c[1] = q.b1 * scale;
+            c[2] = q.b2 * scale;
+            c[3] = q.a1 * scale;
+            c[4] = q.a2 * scale;
+        }
+        
+        static complex_t getResponse (const double* c, double w)
+        {
+            const complex_t z1 = std::polar (1., -w);
+            const complex_t z2 = std::polar (1., -2 * w);
+            return (c[0] + c[1] * z1 + c[2] * z2) / (1. - c[3] * z1 - c[4] * z2);
+        }
+        
+        // With samples within +-2^31 and the coefficients summing to at most
+        // 2^32 - 8 units, the products stay below 2^63 - 2^34, which leaves
+        // room for the rounding and the fed back errors.
+        static void quantize (const BiquadBase& s, Coefficients& q)
+        {
+            double c[5];
+            getCoefficients (s, c);
+            
+            double sum = 0;
+            double peak = 0;
+            for (int i = 0; i < 5; ++i)
+            {
+                sum += std::abs (c[i]);
+                peak = std::max (peak, std::abs (c[i]));
+            }
+            
+            int shift = 30;
+            while (shift > 0 && (std::ldexp (sum, shift) + 8 > 4294967296. ||
+                                 std::ldexp (peak, shift) + 1 > 2147483647.))
+                --shift;
+            
+            q.shift = shift;
+            q.b0 = static_cast<int32_t> (std::floor (std::ldexp (c[0], shift) + 0.5));
+            q.b1 = static_cast<int32_t> (std::floor (std::ldexp (c[1], shift) + 0.5));
+            q.b2 = static_cast<int32_t> (std::floor (std::ldexp (c[2], shift) + 0.5));
+            q.a1 = static_cast<int32_t> (std::floor (std::ldexp (c[3], shift) + 0.5));
+            q.a2 = static_cast<int32_t> (std::floor (std::ldexp (c[4], shift) + 0.5));
+        }
+        
+        static StageFunction selectStage (int level)
+        {
+            switch (level)
+            {
+#if DSPFILTERS_DISPATCH
+                case simdAVX512:
+                case simdAVX2:
+                    return &processStageAVX2;
+#endif
+#if DSPFILTERS_NEON
+                case simdNEON:
+                    return &processStageNEON;
+#endif
+                default:
+                    return &processStageScalar;
+            }
+        }
+        
+        // The tile holds eight lanes per frame, the first width of them in
+        // use. Arithmetic right shifts of negative values round down on
+        // every compiler this runs on.
+        static void processStageScalar (const Coefficients& c, StageState& s,
+                                        int32_t* tile, int numFrames, int offset, int width)
+        {
+            const int64_t high = (static_cast<int64_t> (1) << (c.shift + 31)) - 1;
+            const int64_t low = -high - 1;
+            const int64_t mask = (static_cast<int64_t> (1) << c.shift) - 1;
+            const int64_t half = (ErrorOrder == 0) ? (mask + 1) / 2 : 0;
+            
+            for (int lane = 0; lane < width; ++lane)
+            {
+                const int index = offset + lane;
+                int64_t x1 = s.x1[index], x2 = s.x2[index];
+                int64_t y1 = s.y1[index], y2 = s.y2[index];
+                int64_t e1 = s.e1[index], e2 = s.e2[index];
+                
+                for (int i = 0; i < numFrames; ++i)
+                {
+                    const int64_t x = tile[i * TileLanes + lane];
+                    
+                    int64_t acc = c.b0 * x + c.b1 * x1 + c.b2 * x2 + c.a1 * y1 + c.a2 * y2 + half;
+                    if (ErrorOrder == 1)
+                        acc += e1;
+                    else if (ErrorOrder == 2)
+                        acc += 2 * e1 - e2;
+                    
+                    acc = std::min (std::max (acc, low), high);
+                    
+                    const int64_t y = acc >> c.shift;
+                    e2 = e1;
+                    e1 = acc & mask;
+                    x2 = x1;
+                    x1 = x;
+                    y2 = y1;
+                    y1 = y;
+                    
+                    tile[i * TileLanes + lane] = static_cast<int32_t> (y);
+                }
+                
+                s.x1[index] = static_cast<int32_t> (x1);
+                s.x2[index] = static_cast<int32_t> (x2);
+                s.y1[index] = static_cast<int32_t> (y1);
+                s.y2[index] = static_cast<int32_t> (y2);
+                s.e1[index] = e1;
+                s.e2[index] = e2;
+            }
+        }
+        
+#if DSPFILTERS_DISPATCH
+        // Four lanes per register. vpmuldq multiplies the low 32 bits of
+        // each 64 bit lane, so the samples can ride in 64 bit lanes with
+        // whatever is above them. There is no arithmetic 64 bit shift in
+        // AVX2, but with the accumulator clamped, the low 32 bits of the
+        // logical shift are the same.
+        static void processStageAVX2 (const Coefficients& c, StageState& s,
+                                      int32_t* tile, int numFrames, int offset, int width)
+        {
+            if (width > 4)
+                processLanesAVX2<2> (c, s, tile, numFrames, offset);
+            else
+                processLanesAVX2<1> (c, s, tile, numFrames, offset);
+        }
+        
+        template <int Vectors>
+        DSPFILTERS_TARGET_AVX2
+        static void processLanesAVX2 (const Coefficients& c, StageState& s,
+                                      int32_t* tile, int numFrames, int offset)
+        {
+            const __m256i b0 = _mm256_set1_epi64x (c.b0);
+            const __m256i b1 = _mm256_set1_epi64x (c.b1);
+            const __m256i b2 = _mm256_set1_epi64x (c.b2);
+            const __m256i a1 = _mm256_set1_epi64x (c.a1);
+            const __m256i a2 = _mm256_set1_epi64x (c.a2);
+            
+            const int64_t highValue = (static_cast<int64_t> (1) << (c.shift + 31)) - 1;
+            const int64_t maskValue = (static_cast<int64_t> (1) << c.shift) - 1;
+            const __m256i high = _mm256_set1_epi64x (highValue);
+            const __m256i low = _mm256_set1_epi64x (-highValue - 1);
+            const __m256i mask = _mm256_set1_epi64x (maskValue);
+            const __m256i half = _mm256_set1_epi64x ((ErrorOrder == 0) ? (maskValue + 1) / 2 : 0);
+            const __m128i shift = _mm_cvtsi32_si128 (c.shift);
+            const __m256i pack = _mm256_setr_epi32 (0, 2, 4, 6, 0, 2, 4, 6);
+            
+            __m256i x1[Vectors], x2[Vectors], y1[Vectors], y2[Vectors], e1[Vectors], e2[Vectors];
+            for (int v = 0; v < Vectors; ++v)
+            {
+                const int index = offset + 4 * v;
+                x1[v] = _mm256_cvtepi32_epi64 (_mm_loadu_si128 ((const __m128i*) (s.x1 + index)));
+                x2[v] = _mm256_cvtepi32_epi64 (_mm_loadu_si128 ((const __m128i*) (s.x2 + index)));
+                y1[v] = _mm256_cvtepi32_epi64 (_mm_loadu_si128 ((const __m128i*) (s.y1 + index)));
+                y2[v] = _mm256_cvtepi32_epi64 (_mm_loadu_si128 ((const __m128i*) (s.y2 + index)));
+                e1[v] = _mm256_loadu_si256 ((const __m256i*) (s.e1 + index));
+                e2[v] = _mm256_loadu_si256 ((const __m256i*) (s.e2 + index));
+            }
+            
+            for (int i = 0; i < numFrames; ++i)
+            {
+                for (int v = 0; v < Vectors; ++v)
+                {
+                    int32_t* frame = tile + i * TileLanes + 4 * v;
+                    const __m256i x = _mm256_cvtepi32_epi64 (_mm_loadu_si128 ((const __m128i*) frame));
+                    
+                    __m256i acc = _mm256_add_epi64 (_mm256_mul_epi32 (b0, x), _mm256_mul_epi32 (b1, x1[v]));
+                    acc = _mm256_add_epi64 (acc, _mm256_add_epi64 (_mm256_mul_epi32 (b2, x2[v]), half));
+                    acc = _mm256_add_epi64 (acc, _mm256_add_epi64 (_mm256_mul_epi32 (a1, y1[v]),
+                                                                   _mm256_mul_epi32 (a2, y2[v])));
+                    if (ErrorOrder == 1)
+                        acc = _mm256_add_epi64 (acc, e1[v]);
+                    else if (ErrorOrder == 2)
+                        acc = _mm256_add_epi64 (acc, _mm256_sub_epi64 (_mm256_slli_epi64 (e1[v], 1), e2[v]));
+                    
+                    acc = _mm256_blendv_epi8 (acc, high, _mm256_cmpgt_epi64 (acc, high));
+                    acc = _mm256_blendv_epi8 (acc, low, _mm256_cmpgt_epi64 (low, acc));
+                    
+                    const __m256i y = _mm256_srl_epi64 (acc, shift);
+                    e2[v] = e1[v];
+                    e1[v] = _mm256_and_si256 (acc, mask);
+                    x2[v] = x1[v];
+                    x1[v] = x;
+                    y2[v] = y1[v];
+                    y1[v] = y;
+                    
+                    _mm_storeu_si128 ((__m128i*) frame, _mm256_castsi256_si128 (_mm256_permutevar8x32_epi32 (y, pack)));
+                }
+            }
+            
+            for (int v = 0; v < Vectors; ++v)
+            {
+                const int index = offset + 4 * v;
+                _mm_storeu_si128 ((__m128i*) (s.x1 + index), _mm256_castsi256_si128 (_mm256_permutevar8x32_epi32 (x1[v], pack)));
+                _mm_storeu_si128 ((__m128i*) (s.x2 + index), _mm256_castsi256_si128 (_mm256_permutevar8x32_epi32 (x2[v], pack)));
+                _mm_storeu_si128 ((__m128i*) (s.y1 + index), _mm256_castsi256_si128 (_mm256_permutevar8x32_epi32 (y1[v], pack)));
+                _mm_storeu_si128 ((__m128i*) (s.y2 + index), _mm256_castsi256_si128 (_mm256_permutevar8x32_epi32 (y2[v], pack)));
+                _mm256_storeu_si256 ((__m256i*) (s.e1 + index), e1[v]);
+                _mm256_storeu_si256 ((__m256i*) (s.e2 + index), e2[v]);
+            }
+        }
+#endif
+        
+#if DSPFILTERS_NEON
+        // Two lanes per register, with widening multiply-accumulates
+        static void processStageNEON (const Coefficients& c, StageState& s,
+                                      int32_t* tile, int numFrames, int offset, int width)
+        {
+            const int32x2_t b0 = vdup_n_s32 (c.b0);
+            const int32x2_t b1 = vdup_n_s32 (c.b1);
+            const int32x2_t b2 = vdup_n_s32 (c.b2);
+            const int32x2_t a1 = vdup_n_s32 (c.a1);
+            const int32x2_t a2 = vdup_n_s32 (c.a2);
+            
+            const int64_t highValue = (static_cast<int64_t> (1) << (c.shift + 31)) - 1;
+            const int64_t maskValue = (static_cast<int64_t> (1) << c.shift) - 1;
+            const int64x2_t high = vdupq_n_s64 (highValue);
+            const int64x2_t low = vdupq_n_s64 (-highValue - 1);
+            const int64x2_t mask = vdupq_n_s64 (maskValue);
+            const int64x2_t half = vdupq_n_s64 ((ErrorOrder == 0) ? (maskValue + 1) / 2 : 0);
+            const int64x2_t shift = vdupq_n_s64 (-c.shift);
+            
+            for (int pair = 0; pair < width; pair += 2)
+            {
+                const int index = offset + pair;
+                int32x2_t x1 = vld1_s32 (s.x1 + index);
+                int32x2_t x2 = vld1_s32 (s.x2 + index);
+                int32x2_t y1 = vld1_s32 (s.y1 + index);
+                int32x2_t y2 = vld1_s32 (s.y2 + index);
+                int64x2_t e1 = vld1q_s64 (s.e1 + index);
+                int64x2_t e2 = vld1q_s64 (s.e2 + index);
+                
+                for (int i = 0; i < numFrames; ++i)
+                {
+                    const int32x2_t x = vld1_s32 (tile + i * TileLanes + pair);
+                    
+                    int64x2_t acc = vmlal_s32 (half, b0, x);
+                    acc = vmlal_s32 (acc, b1, x1);
+                    acc = vmlal_s32 (acc, b2, x2);
+                    acc = vmlal_s32 (acc, a1, y1);
+                    acc = vmlal_s32 (acc, a2, y2);
+                    if (ErrorOrder == 1)
+                        acc = vaddq_s64 (acc, e1);
+                    else if (ErrorOrder == 2)
+                        acc = vaddq_s64 (acc, vsubq_s64 (vshlq_n_s64 (e1, 1), e2));
+                    
+                    acc = vbslq_s64 (vcgtq_s64 (acc, high), high, acc);
+                    acc = vbslq_s64 (vcltq_s64 (acc, low), low, acc);
+                    
+                    const int32x2_t y = vmovn_s64 (vshlq_s64 (acc, shift));
+                    e2 = e1;
+                    e1 = vandq_s64 (acc, mask);
+                    x2 = x1;
+                    x1 = x;
+                    y2 = y1;
+                    y1 = y;
+                    
+                    vst1_s32 (tile + i * TileLanes + pair, y);
+                }
+                
+                vst1_s32 (s.x1 + index, x1);
+                vst1_s32 (s.x2 + index, x2);
+                vst1_s32 (s.y1 + index, y1);
+                vst1_s32 (s.y2 + index, y2);
+                vst1q_s64 (s.e1 + index, e1);
+                vst1q_s64 (s.e2 + index, e2);
+            }
+        }
+#endif
+        
+        int m_numStages;
+        StageFunction m_processStage;
+        Biquad m_source[MaxStages];
+        Coefficients m_coefficients[MaxStages];
+        StageState m_states[MaxStages];
+        int32_t m_tile[TileFrames * TileLanes];
+    };
+}
+
+#endif
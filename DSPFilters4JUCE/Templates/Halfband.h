@@ -0,0 +1,558 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_HALFBAND_H
+#define DSPFILTERS_HALFBAND_H
+
+/*
+ * Polyphase IIR halfband filters for 2x, 4x and 8x resampling
+ *
+ * A halfband low pass built from two parallel allpass chains:
+ *
+ *   H(z) = ( A0(z^2) + z^-1 A1(z^2) ) / 2
+ *
+ * Both chains only depend on z^2, so when decimating or interpolating
+ * by two each of them runs at the low rate, on every other sample. The
+ * chains are made of first order allpass sections, one coefficient each.
+ *
+ * The designer places the coefficients for an elliptic response, after
+ * Laurent de Soras' HIIR library and the references in there:
+ *
+ * http://ldesoras.free.fr/prod.html#src_hiir
+ *
+ * Transition bandwidths are given relative to the high sample rate of a
+ * stage, so the pass band reaches up to (0.25 - transition) and the stop
+ * band begins at (0.25 + transition). Attenuation is in positive dB.
+ *
+ */
+
+namespace Halfband
+{
+    class Designer
+    {
+    public:
+        // Number of coefficients needed to reach the given attenuation
+        static int getNumCoefs (double attenuation, double transition)
+        {
+            assert (attenuation > 0);
+            assert (transition > 0 && transition < 0.5);
+            
+            double k;
+            double q;
+            getTransitionParams (k, q, transition);
+            
+            const double attnP2 = pow (10., -attenuation / 10);
+            const double a = attnP2 / (1 - attnP2);
+            int order = static_cast<int> (ceil (log (a * a / 16) / log (q)));
+            if ((order & 1) == 0)
+                ++order;
+            if (order == 1)
+                order = 3;
+            
+            return (order - 1) / 2;
+        }
+        
+        // Coefficients for a given number of sections, even indices go
+        // into the first allpass chain, odd indices into the second.
+        static void getCoefs (double* coefs, int numCoefs, double transition)
+        {
+            assert (numCoefs > 0);
+            assert (transition > 0 && transition < 0.5);
+            
+            double k;
+            double q;
+            getTransitionParams (k, q, transition);
+            
+            const int order = numCoefs * 2 + 1;
+            for (int i = 0; i < numCoefs; ++i)
+            {
+                const int c = i + 1;
+                const double num = getAccNum (q, order, c) * pow (q, 0.25);
+                const double den = getAccDen (q, order, c) + 0.5;
+                const double ww = num / den;
+                const double wwsq = ww * ww;
+                const double x = sqrt ((1 - wwsq * k) * (1 - wwsq / k)) / (1 + wwsq);
+                coefs[i] = (1 - x) / (1 + x);
+            }
+        }
+        
+        // Group delay at DC, in samples of the high rate
+        static double getDelay (const double* coefs, int numCoefs)
+        {
+            // a first order allpass (c + z^-1) / (1 + c z^-1) is delayed
+            // by (1 - c) / (1 + c) samples at DC, twice that at the high
+            double delay[2] = { 0, 1 };
+            for (int i = 0; i < numCoefs; ++i)
+                delay[i & 1] += 2 * (1 - coefs[i]) / (1 + coefs[i]);
+            return (delay[0] + delay[1]) / 2;
+        }
+        
+    private:
+        static void getTransitionParams (double& k, double& q, double transition)
+        {
+            k = tan ((1 - transition * 2) * doublePi / 4);
+            k *= k;
+            const double kksqrt = pow (1 - k * k, 0.25);
+            const double e = 0.5 * (1 - kksqrt) / (1 + kksqrt);
+            const double e2 = e * e;
+            const double e4 = e2 * e2;
+            q = e * (1 + e4 * (2 + e4 * (15 + 150 * e4)));
+        }
+        
+        static double getAccNum (double q, int order, int c)
+        {
+            double acc = 0;
+            double term;
+            int sign = 1;
+            int i = 0;
+            do
+            {
+                term = pow (q, i * (i + 1)) * sin ((i * 2 + 1) * c * doublePi / order) * sign;
+                acc += term;
+                sign = -sign;
+                ++i;
+            }
+            while (fabs (term) > 1e-100);
+            return acc;
+        }
+        
+        static double getAccDen (double q, int order, int c)
+        {
+            double acc = 0;
+            double term;
+            int sign = -1;
+            int i = 1;
+            do
+            {
+                term = pow (q, i * i) * cos (i * 2 * c * doublePi / order) * sign;
+                acc += term;
+                sign = -sign;
+                ++i;
+            }
+            while (fabs (term) > 1e-100);
+            return acc;
+        }
+    };
+    
+//------------------------------------------------------------------------------
+    
+    // Coefficients and states of both allpass chains
+    template <int MaxCoefs>
+    class Polyphase
+    {
+    public:
+        Polyphase () : m_numCoefs (0)
+        {
+            reset ();
+        }
+        
+        int getNumCoefs () const
+        {
+            return m_numCoefs;
+        }
+        
+        // Group delay at DC, in samples of the high rate
+        double getDelay () const
+        {
+            return Designer::getDelay (m_coefs, m_numCoefs);
+        }
+        
+        void reset ()
+        {
+            for (int i = 0; i < MaxCoefs; ++i)
+            {
+                m_x[i] = 0;
+                m_y[i] = 0;
+            }
+        }
+        
+        void setup (const double* coefs, int numCoefs)
+        {
+            assert (numCoefs > 0 && numCoefs <= MaxCoefs);
+            m_numCoefs = numCoefs;
+            for (int i = 0; i < numCoefs; ++i)
+                m_coefs[i] = coefs[i];
+        }
+        
+        // Designs the coefficients itself, with as few sections as the
+        // attenuation allows. More than MaxCoefs would need are cut off.
+        void setup (double attenuation, double transition)
+        {
+            double coefs[MaxCoefs];
+            const int numCoefs = std::min (Designer::getNumCoefs (attenuation, transition), MaxCoefs);
+            Designer::getCoefs (coefs, numCoefs, transition);
+            setup (coefs, numCoefs);
+        }
+        
+    protected:
+        // Runs one sample through each chain
+        inline void processChains (double& even, double& odd)
+        {
+            int i = 0;
+            for (; i + 1 < m_numCoefs; i += 2)
+            {
+                even = processStage (i, even);
+                odd = processStage (i + 1, odd);
+            }
+            if (i < m_numCoefs)
+                even = processStage (i, even);
+        }
+        
+        inline double processStage (int i, double in)
+        {
+            const double out = (in - m_y[i]) * m_coefs[i] + m_x[i];
+            m_x[i] = in;
+            m_y[i] = out;
+            return out;
+        }
+        
+        int m_numCoefs;
+        double m_coefs[MaxCoefs];
+        double m_x[MaxCoefs];
+        double m_y[MaxCoefs];
+    };
+    
+//------------------------------------------------------------------------------
+    
+    // Two samples in, one out
+    template <int MaxCoefs>
+    class Decimator2x : public Polyphase <MaxCoefs>
+    {
+    public:
+        template <typename Sample>
+        inline Sample process (const Sample* in)
+        {
+            double even = in[1];
+            double odd = in[0];
+            Polyphase <MaxCoefs>::processChains (even, odd);
+            return static_cast<Sample> ((even + odd) * 0.5);
+        }
+    };
+    
+    // One sample in, two out
+    template <int MaxCoefs>
+    class Interpolator2x : public Polyphase <MaxCoefs>
+    {
+    public:
+        template <typename Sample>
+        inline void process (const Sample in, Sample* out)
+        {
+            double even = in;
+            double odd = in;
+            Polyphase <MaxCoefs>::processChains (even, odd);
+            out[0] = static_cast<Sample> (even);
+            out[1] = static_cast<Sample> (odd);
+        }
+    };
+    
+//------------------------------------------------------------------------------
+    
+    //
+    // Chains of 2x stages for factors of 1, 2, 4 and 8.
+    //
+    // Only the stage next to the low rate needs the full steepness. The
+    // stages further out only have to protect the pass band of the final
+    // rate, everything they let alias gets removed by the following ones.
+    // So they get away with a wider transition and fewer coefficients.
+    //
+    template <class Stage, int MaxCoefs>
+    class MultiStage
+    {
+    public:
+        enum
+        {
+            MaxStages = 3,
+            MaxFactor = 1 << MaxStages
+        };
+        
+        MultiStage () : m_numStages (0)
+        {
+        }
+        
+        int getFactor () const
+        {
+            return 1 << m_numStages;
+        }
+        
+        void reset ()
+        {
+            for (int i = 0; i < MaxStages; ++i)
+                m_stages[i].reset ();
+        }
+        
+        // Stage 0 sits at the low rate, the last one at the high rate
+        void setup (int factor, double attenuation, double transition)
+        {
+            assert (factor == 1 || factor == 2 || factor == 4 || factor == 8);
+            
+            m_numStages = 0;
+            while ((1 << m_numStages) < factor)
+                ++m_numStages;
+            
+            double passBand = 0.25 - transition;
+            for (int i = 0; i < m_numStages; ++i)
+            {
+                m_stages[i].setup (attenuation, 0.25 - passBand);
+                passBand *= 0.5;
+            }
+        }
+        
+        // Group delay at DC, in samples of the low rate. For decimators
+        // this counts from the newest of the input samples.
+        double getDelay () const
+        {
+            double delay = 0;
+            double scale = 0.5;
+            for (int i = 0; i < m_numStages; ++i)
+            {
+                delay += m_stages[i].getDelay () * scale;
+                scale *= 0.5;
+            }
+            return delay;
+        }
+        
+    protected:
+        int m_numStages;
+        Stage m_stages[MaxStages];
+    };
+    
+    // getFactor() samples in, one out
+    template <int MaxCoefs = 12>
+    class Decimator : public MultiStage <Decimator2x <MaxCoefs>, MaxCoefs>
+    {
+    public:
+        typedef MultiStage <Decimator2x <MaxCoefs>, MaxCoefs> Base;
+        
+        template <typename Sample>
+        Sample process (const Sample* in)
+        {
+            const int numStages = Base::m_numStages;
+            if (numStages == 0)
+                return in[0];
+            
+            double buffer[Base::MaxFactor];
+            int count = 1 << numStages;
+            for (int i = 0; i < count; ++i)
+                buffer[i] = in[i];
+            
+            for (int stage = numStages; --stage >= 0;)
+            {
+                count /= 2;
+                for (int i = 0; i < count; ++i)
+                    buffer[i] = Base::m_stages[stage].process (buffer + 2 * i);
+            }
+            
+            return static_cast<Sample> (buffer[0]);
+        }
+    };
+    
+    // One sample in, getFactor() out
+    template <int MaxCoefs = 12>
+    class Interpolator : public MultiStage <Interpolator2x <MaxCoefs>, MaxCoefs>
+    {
+    public:
+        typedef MultiStage <Interpolator2x <MaxCoefs>, MaxCoefs> Base;
+        
+        template <typename Sample>
+        void process (const Sample in, Sample* out)
+        {
+            const int numStages = Base::m_numStages;
+            if (numStages == 0)
+            {
+                out[0] = in;
+                return;
+            }
+            
+            double buffer[Base::MaxFactor];
+            double upsampled[Base::MaxFactor];
+            buffer[0] = in;
+            
+            int count = 1;
+            for (int stage = 0; stage < numStages; ++stage)
+            {
+                for (int i = 0; i < count; ++i)
+                    Base::m_stages[stage].process (buffer[i], upsampled + 2 * i);
+                count *= 2;
+                for (int i = 0; i < count; ++i)
+                    buffer[i] = upsampled[i];
+            }
+            
+            for (int i = 0; i < count; ++i)
+                out[i] = static_cast<Sample> (buffer[i]);
+        }
+    };
+    
+//------------------------------------------------------------------------------
+    
+    //
+    // Runs a filter at 1/factor of the sample rate.
+    //
+    // The input is collected into frames of factor samples, every frame is
+    // decimated to one sample, filtered, and interpolated back into a frame
+    // of output. So the output runs one frame behind the input, plus the
+    // delay of the halfband filters.
+    //
+    // Decimating throws away everything above the low rate's pass band.
+    // That's fine for filters that don't let anything through up there
+    // (low pass, band pass), so for these the result simply replaces the
+    // input. Filters that pass the high frequencies untouched (high pass,
+    // band stop, low shelf, ...) only change the lows, so for these only
+    // the difference is interpolated and added to a delayed copy of the
+    // input. The highs never go through the resamplers at all then.
+    //
+    // Either way the filter has to be designed for the low sample rate.
+    //
+    template <int MaxCoefs = 12>
+    class Multirate
+    {
+    public:
+        enum
+        {
+            MaxFactor = MultiStage <Decimator2x <MaxCoefs>, MaxCoefs>::MaxFactor
+        };
+        
+        Multirate () : m_factor (1), m_bandLimited (true)
+        {
+            reset ();
+        }
+        
+        int getFactor () const
+        {
+            return m_factor;
+        }
+        
+        // In samples of the full rate
+        double getLatency () const
+        {
+            if (m_factor == 1)
+                return 0;
+            
+            return 1 + m_factor * (m_down.getDelay () + m_up.getDelay ());
+        }
+        
+        void reset ()
+        {
+            m_down.reset ();
+            m_up.reset ();
+            m_position = 0;
+            for (int i = 0; i < MaxFactor; ++i)
+            {
+                m_frame[i] = 0;
+                m_output[i] = 0;
+            }
+            m_delayPosition = 0;
+            std::fill (m_delay.begin (), m_delay.end (), 0.);
+        }
+        
+        void setup (int factor, bool bandLimited, double attenuation, double transition)
+        {
+            m_factor = factor;
+            m_bandLimited = bandLimited;
+            m_down.setup (factor, attenuation, transition);
+            m_up.setup (factor, attenuation, transition);
+            
+            // the direct path can only be delayed by whole samples, the
+            // fraction left over is a tiny phase shift at the low rate
+            const int delay = static_cast<int> (getLatency () + 0.5);
+            m_delay.assign ((bandLimited || factor == 1) ? 0 : delay, 0.);
+            
+            reset ();
+        }
+        
+        // The filter is called once per frame, with a sample of the low rate
+        template <typename Sample, class Filter>
+        inline Sample process (const Sample in, Filter filter)
+        {
+            if (m_factor == 1)
+                return static_cast<Sample> (filter (in));
+            
+            double out = m_output[m_position];
+            
+            if (!m_bandLimited)
+                out += delay (in);
+            
+            m_frame[m_position] = in;
+            
+            if (++m_position == m_factor)
+            {
+                m_position = 0;
+                
+                const double low = m_down.process (m_frame);
+                double filtered = filter (low);
+                if (!m_bandLimited)
+                    filtered -= low;
+                
+                m_up.process (filtered, m_output);
+            }
+            
+            return static_cast<Sample> (out);
+        }
+        
+    private:
+        inline double delay (double in)
+        {
+            if (m_delay.empty ())
+                return in;
+            
+            const double out = m_delay[m_delayPosition];
+            m_delay[m_delayPosition] = in;
+            if (++m_delayPosition == static_cast<int> (m_delay.size ()))
+                m_delayPosition = 0;
+            return out;
+        }
+        
+        int m_factor;
+        bool m_bandLimited;
+        Decimator <MaxCoefs> m_down;
+        Interpolator <MaxCoefs> m_up;
+        
+        int m_position;
+        double m_frame[MaxFactor];
+        double m_output[MaxFactor];
+        
+        int m_delayPosition;
+        std::vector<double> m_delay;
+    };
+    
+}
+
+#endif
@@ -0,0 +1,466 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+
+#ifndef DSPFILTERS_INTERLEAVED_H
+#define DSPFILTERS_INTERLEAVED_H
+
+/*
+ * Cascade for interleaved multichannel audio
+ *
+ * Filters frames of interleaved channels right where they are, in place,
+ * without splitting them into one buffer per channel and back. All
+ * channels share the coefficients, and the states are interleaved the same
+ * way as the audio: for every stage there is a row of v[-1] for all
+ * channels, then a row of v[-2]. So one SSE2 or NEON register holds the
+ * states of two adjacent channels of a frame, an AVX2 register those of
+ * four, and no register ever has to be shuffled.
+ *
+ * The frames are converted to double a tile at a time. Each stage then
+ * runs across the whole tile with its states in registers, two registers
+ * side by side so that their recursions hide each other's latency. The
+ * rows are padded to a multiple of four channels, the padding just
+ * filters silence.
+ *
+ * The stages are Direct Form II, with the same results bit for bit as
+ * DirectFormII in State.h on the scalar, SSE2 and NEON paths. AVX2 uses
+ * fused multiply-adds, which differ by a rounding.
+ *
+ * There are no ramps. New coefficients take effect at once and clear the
+ * states, as a redesign with reset () would in a regular cascade.
+ *
+ */
+
+namespace Interleaved
+{
+    template <int MaxStages>
+    class Stages
+    {
+    public:
+        enum
+        {
+            LaneAlignment = 4,          // one AVX2 register of doubles
+            TileSize = 2048             // doubles, 16KB
+        };
+        
+        Stages ()
+        : m_numStages (0)
+        , m_numChannels (0)
+        , m_lanes (0)
+        , m_tileFrames (0)
+        , m_processTile (&processTileScalar)
+        {
+        }
+        
+        // Takes over the coefficients. The states are kept if they
+        // are the same as before, and reset if anything changed.
+        void setup (const Biquad* stages, int numStages)
+        {
+            assert (numStages >= 0 && numStages <= MaxStages);
+            
+            m_processTile = selectTile (getSimdLevel ());
+            
+            bool changed = (numStages != m_numStages);
+            m_numStages = numStages;
+            
+            for (int i = 0; i < numStages; ++i)
+            {
+                Coefficients& c = m_coefficients[i];
+                changed = changed || c.a1 != stages[i].m_a1 || c.a2 != stages[i].m_a2
+                                  || c.b0 != stages[i].m_b0 || c.b1 != stages[i].m_b1
+                                  || c.b2 != stages[i].m_b2;
+                c.a1 = stages[i].m_a1;
+                c.a2 = stages[i].m_a2;
+                c.b0 = stages[i].m_b0;
+                c.b1 = stages[i].m_b1;
+                c.b2 = stages[i].m_b2;
+            }
+            
+            if (changed)
+                reset ();
+        }
+        
+        void setup (::DSP::Templates::Cascade& cascade)
+        {
+            Biquad stages[MaxStages];
+            for (int i = 0; i < cascade.getNumStages (); ++i)
+                stages[i] = cascade[i];
+            
+            setup (stages, cascade.getNumStages ());
+        }
+        
+        // Allocates the states and the tile, and clears them, but only if
+        // the number of channels changed. process() calls this anyway.
+        void prepare (int numChannels)
+        {
+            assert (numChannels > 0);
+            
+            if (numChannels != m_numChannels)
+            {
+                m_numChannels = numChannels;
+                m_lanes = (numChannels + LaneAlignment - 1) & ~(LaneAlignment - 1);
+                m_tileFrames = std::max (8, TileSize / m_lanes);
+                m_states.assign (2 * MaxStages * m_lanes, 0.);
+                m_tile.assign (m_tileFrames * m_lanes, 0.);
+            }
+        }
+        
+        int getNumChannels () const
+        {
+            return m_numChannels;
+        }
+        
+        void reset ()
+        {
+            std::fill (m_states.begin (), m_states.end (), 0.);
+        }
+        
+        // Filters numFrames frames of numChannels interleaved channels in place
+        template <typename Sample>
+        void process (int numFrames, Sample* data, int numChannels)
+        {
+            prepare (numChannels);
+            
+            const int lanes = m_lanes;
+            double* const tile = &m_tile[0];
+            
+            for (int start = 0; start < numFrames; start += m_tileFrames)
+            {
+                const int n = std::min (m_tileFrames, numFrames - start);
+                Sample* const frames = data + static_cast<size_t> (start) * numChannels;
+                
+                for (int i = 0; i < n; ++i)
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        tile[i * lanes + channel] = frames[i * numChannels + channel];
+                
+                m_processTile (m_coefficients, m_numStages, &m_states[0], tile, n, lanes);
+                
+                for (int i = 0; i < n; ++i)
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        frames[i * numChannels + channel] = static_cast<Sample> (tile[i * lanes + channel]);
+            }
+        }
+        
+    private:
+        struct Coefficients
+        {
+            double a1;
+            double a2;
+            double b0;
+            double b1;
+            double b2;
+        };
+        
+        // The states of stage k are the rows 2k (v[-1]) and 2k+1 (v[-2])
+        typedef void (*TileFunction) (const Coefficients* c, int numStages, double* states,
+                                      double* tile, int numFrames, int lanes);
+        
+        static TileFunction selectTile (int level)
+        {
+            switch (level)
+            {
+                case simdScalar:
+                    return &processTileScalar;
+#if DSPFILTERS_DISPATCH
+                case simdAVX512:
+                case simdAVX2:
+                    return &processTileAVX2;
+#endif
+                default:
+#if DSPFILTERS_SSE2
+                    return &processTileSSE2;
+#elif DSPFILTERS_NEON
+                    return &processTileNEON;
+#else
+                    return &processTileScalar;
+#endif
+            }
+        }
+        
+        static void processTileScalar (const Coefficients* c, int numStages, double* states,
+                                       double* tile, int numFrames, int lanes)
+        {
+            for (int k = 0; k < numStages; ++k)
+            {
+                const double a1 = c[k].a1;
+                const double a2 = c[k].a2;
+                const double b0 = c[k].b0;
+                const double b1 = c[k].b1;
+                const double b2 = c[k].b2;
+                double* const row1 = states + 2 * k * lanes;
+                double* const row2 = row1 + lanes;
+                
+                for (int lane = 0; lane < lanes; ++lane)
+                {
+                    double v1 = row1[lane];
+                    double v2 = row2[lane];
+                    double* x = tile + lane;
+                    
+                    for (int i = 0; i < numFrames; ++i, x += lanes)
+                    {
+                        const double w = *x - a1*v1 - a2*v2;
+                        *x = b0*w + b1*v1 + b2*v2;
+                        v2 = v1;
+                        v1 = w;
+                    }
+                    
+                    row1[lane] = v1;
+                    row2[lane] = v2;
+                }
+            }
+        }
+        
+#if DSPFILTERS_SSE2
+        // Two registers, four channels per pass
+        static void processTileSSE2 (const Coefficients* c, int numStages, double* states,
+                                     double* tile, int numFrames, int lanes)
+        {
+            for (int k = 0; k < numStages; ++k)
+            {
+                const __m128d a1 = _mm_set1_pd (c[k].a1);
+                const __m128d a2 = _mm_set1_pd (c[k].a2);
+                const __m128d b0 = _mm_set1_pd (c[k].b0);
+                const __m128d b1 = _mm_set1_pd (c[k].b1);
+                const __m128d b2 = _mm_set1_pd (c[k].b2);
+                double* const row1 = states + 2 * k * lanes;
+                double* const row2 = row1 + lanes;
+                
+                for (int lane = 0; lane < lanes; lane += 4)
+                {
+                    __m128d v1a = _mm_loadu_pd (row1 + lane);
+                    __m128d v1b = _mm_loadu_pd (row1 + lane + 2);
+                    __m128d v2a = _mm_loadu_pd (row2 + lane);
+                    __m128d v2b = _mm_loadu_pd (row2 + lane + 2);
+                    double* x = tile + lane;
+                    
+                    for (int i = 0; i < numFrames; ++i, x += lanes)
+                    {
+                        const __m128d wa = _mm_sub_pd (_mm_sub_pd (_mm_loadu_pd (x), _mm_mul_pd (a1, v1a)), _mm_mul_pd (a2, v2a));
+                        const __m128d wb = _mm_sub_pd (_mm_sub_pd (_mm_loadu_pd (x + 2), _mm_mul_pd (a1, v1b)), _mm_mul_pd (a2, v2b));
+                        _mm_storeu_pd (x, _mm_add_pd (_mm_add_pd (_mm_mul_pd (b0, wa), _mm_mul_pd (b1, v1a)), _mm_mul_pd (b2, v2a)));
+                        _mm_storeu_pd (x + 2, _mm_add_pd (_mm_add_pd (_mm_mul_pd (b0, wb), _mm_mul_pd (b1, v1b)), _mm_mul_pd (b2, v2b)));
+                        v2a = v1a;
+                        v2b = v1b;
+                        v1a = wa;
+                        v1b = wb;
+                    }
+                    
+                    _mm_storeu_pd (row1 + lane, v1a);
+                    _mm_storeu_pd (row1 + lane + 2, v1b);
+                    _mm_storeu_pd (row2 + lane, v2a);
+                    _mm_storeu_pd (row2 + lane + 2, v2b);
+                }
+            }
+        }
+#endif
+        
+#if DSPFILTERS_NEON
+        // Separate multiplies and adds, no vfmaq, to match the scalar code
+        static void processTileNEON (const Coefficients* c, int numStages, double* states,
+                                     double* tile, int numFrames, int lanes)
+        {
+            for (int k = 0; k < numStages; ++k)
+            {
+                const float64x2_t a1 = vdupq_n_f64 (c[k].a1);
+                const float64x2_t a2 = vdupq_n_f64 (c[k].a2);
+                const float64x2_t b0 = vdupq_n_f64 (c[k].b0);
+                const float64x2_t b1 = vdupq_n_f64 (c[k].b1);
+                const float64x2_t b2 = vdupq_n_f64 (c[k].b2);
+                double* const row1 = states + 2 * k * lanes;
+                double* const row2 = row1 + lanes;
+                
+                for (int lane = 0; lane < lanes; lane += 4)
+                {
+                    float64x2_t v1a = vld1q_f64 (row1 + lane);
+                    float64x2_t v1b = vld1q_f64 (row1 + lane + 2);
+                    float64x2_t v2a = vld1q_f64 (row2 + lane);
+                    float64x2_t v2b = vld1q_f64 (row2 + lane + 2);
+                    double* x = tile + lane;
+                    
+                    for (int i = 0; i < numFrames; ++i, x += lanes)
+                    {
+                        const float64x2_t wa = vsubq_f64 (vsubq_f64 (vld1q_f64 (x), vmulq_f64 (a1, v1a)), vmulq_f64 (a2, v2a));
+                        const float64x2_t wb = vsubq_f64 (vsubq_f64 (vld1q_f64 (x + 2), vmulq_f64 (a1, v1b)), vmulq_f64 (a2, v2b));
+                        vst1q_f64 (x, vaddq_f64 (vaddq_f64 (vmulq_f64 (b0, wa), vmulq_f64 (b1, v1a)), vmulq_f64 (b2, v2a)));
+                        vst1q_f64 (x + 2, vaddq_f64 (vaddq_f64 (vmulq_f64 (b0, wb), vmulq_f64 (b1, v1b)), vmulq_f64 (b2, v2b)));
+                        v2a = v1a;
+                        v2b = v1b;
+                        v1a = wa;
+                        v1b = wb;
+                    }
+                    
+                    vst1q_f64 (row1 + lane, v1a);
+                    vst1q_f64 (row1 + lane + 2, v1b);
+                    vst1q_f64 (row2 + lane, v2a);
+                    vst1q_f64 (row2 + lane + 2, v2b);
+                }
+            }
+        }
+#endif
+        
+#if DSPFILTERS_DISPATCH
+        // Eight channels per pass in two registers, then four in one. Up to
+        // four channels fit in one register, then two stages run side by
+        // side instead, skewed by a frame as in Pipeline.h.
+        static DSPFILTERS_TARGET_AVX2
+        void processTileAVX2 (const Coefficients* c, int numStages, double* states,
+                              double* tile, int numFrames, int lanes)
+        {
+            for (int k = 0; k < numStages; ++k)
+            {
+                double* const row1 = states + 2 * k * lanes;
+                double* const row2 = row1 + lanes;
+                
+                if (lanes == 4 && k + 1 < numStages)
+                {
+                    processStagePairAVX2 (c[k], c[k + 1], row1, tile, numFrames);
+                    ++k;
+                    continue;
+                }
+                
+                int lane = 0;
+                for (; lane + 8 <= lanes; lane += 8)
+                    processLanesAVX2<2> (c[k], row1 + lane, row2 + lane, tile + lane, numFrames, lanes);
+                if (lane < lanes)
+                    processLanesAVX2<1> (c[k], row1 + lane, row2 + lane, tile + lane, numFrames, lanes);
+            }
+        }
+        
+        struct CoefficientsAVX2
+        {
+            __m256d a1;
+            __m256d a2;
+            __m256d b0;
+            __m256d b1;
+            __m256d b2;
+        };
+        
+        static DSPFILTERS_TARGET_AVX2
+        inline CoefficientsAVX2 broadcastAVX2 (const Coefficients& c)
+        {
+            CoefficientsAVX2 r;
+            r.a1 = _mm256_set1_pd (c.a1);
+            r.a2 = _mm256_set1_pd (c.a2);
+            r.b0 = _mm256_set1_pd (c.b0);
+            r.b1 = _mm256_set1_pd (c.b1);
+            r.b2 = _mm256_set1_pd (c.b2);
+            return r;
+        }
+        
+        static DSPFILTERS_TARGET_AVX2
+        inline void stepAVX2 (const CoefficientsAVX2& c, __m256d& v1, __m256d& v2, double* x)
+        {
+            const __m256d w = _mm256_fnmadd_pd (c.a2, v2, _mm256_fnmadd_pd (c.a1, v1, _mm256_loadu_pd (x)));
+            _mm256_storeu_pd (x, _mm256_fmadd_pd (c.b2, v2, _mm256_fmadd_pd (c.b1, v1, _mm256_mul_pd (c.b0, w))));
+            v2 = v1;
+            v1 = w;
+        }
+        
+        template <int Vectors>
+        static DSPFILTERS_TARGET_AVX2
+        void processLanesAVX2 (const Coefficients& coefficients, double* row1, double* row2,
+                               double* x, int numFrames, int lanes)
+        {
+            const CoefficientsAVX2 c = broadcastAVX2 (coefficients);
+            
+            __m256d v1[Vectors];
+            __m256d v2[Vectors];
+            for (int j = 0; j < Vectors; ++j)
+            {
+                v1[j] = _mm256_loadu_pd (row1 + 4 * j);
+                v2[j] = _mm256_loadu_pd (row2 + 4 * j);
+            }
+            
+            for (int i = 0; i < numFrames; ++i, x += lanes)
+                for (int j = 0; j < Vectors; ++j)
+                    stepAVX2 (c, v1[j], v2[j], x + 4 * j);
+            
+            for (int j = 0; j < Vectors; ++j)
+            {
+                _mm256_storeu_pd (row1 + 4 * j, v1[j]);
+                _mm256_storeu_pd (row2 + 4 * j, v2[j]);
+            }
+        }
+        
+        // Two stages of four lanes, the second one a frame behind the first
+        static DSPFILTERS_TARGET_AVX2
+        void processStagePairAVX2 (const Coefficients& first, const Coefficients& second,
+                                   double* states, double* x, int numFrames)
+        {
+            if (numFrames < 1)
+                return;
+            
+            const CoefficientsAVX2 c0 = broadcastAVX2 (first);
+            const CoefficientsAVX2 c1 = broadcastAVX2 (second);
+            
+            __m256d v10 = _mm256_loadu_pd (states);
+            __m256d v20 = _mm256_loadu_pd (states + 4);
+            __m256d v11 = _mm256_loadu_pd (states + 8);
+            __m256d v21 = _mm256_loadu_pd (states + 12);
+            
+            stepAVX2 (c0, v10, v20, x);
+            for (int i = 1; i < numFrames; ++i, x += 4)
+            {
+                stepAVX2 (c0, v10, v20, x + 4);
+                stepAVX2 (c1, v11, v21, x);
+            }
+            stepAVX2 (c1, v11, v21, x);
+            
+            _mm256_storeu_pd (states, v10);
+            _mm256_storeu_pd (states + 4, v20);
+            _mm256_storeu_pd (states + 8, v11);
+            _mm256_storeu_pd (states + 12, v21);
+        }
+#endif
+        
+        int m_numStages;
+        int m_numChannels;
+        int m_lanes;
+        int m_tileFrames;
+        TileFunction m_processTile;
+        Coefficients m_coefficients[MaxStages];
+        std::vector<double> m_states;
+        std::vector<double> m_tile;
+    };
+}
+
+#endif
@@ -0,0 +1,229 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_LINKWITZRILEY_H
+#define DSPFILTERS_LINKWITZRILEY_H
+
+/*
+ * Linkwitz-Riley crossovers
+ *
+ * A Linkwitz-Riley low or high pass of order 2N is a Butterworth low or
+ * high pass of order N, applied twice. Both halves are -6dB at the split
+ * frequency and add up to an allpass with the Butterworth poles, so the
+ * sum is flat. With an odd N the high pass comes out inverted, otherwise
+ * the two halves would cancel around the split frequency.
+ *
+ * Multiple bands are split off one after the other, lowest first:
+ *
+ *   in -> split 1 -> band 1
+ *            '-----> split 2 -> band 2
+ *                       '-----> ...
+ *
+ * Every band that leaves the tree early misses the allpass phase of the
+ * splits further up, so it runs through those allpasses on its own to
+ * line up with the rest again. All bands then sum to one big allpass.
+ *
+ * Every section of every band lives in one array, in the order they run,
+ * so one sample travels through the whole tree in a single pass.
+ *
+ */
+
+namespace LinkwitzRiley
+{
+    // Biquad with directly set coefficients
+    struct Section : BiquadBase
+    {
+        void setup (double a0, double a1, double a2,
+                    double b0, double b1, double b2)
+        {
+            setCoefficients (a0, a1, a2, b0, b1, b2);
+        }
+    };
+    
+//------------------------------------------------------------------------------
+    
+    // Coefficients for a single split frequency. All three responses
+    // share the same Butterworth poles, only the zeros are different.
+    template <int MaxSections>
+    struct Split
+    {
+        void setup (int order, double sampleRate, double splitFrequency)
+        {
+            assert (order >= 2 && (order & 1) == 0);
+            
+            const int poles = order / 2;
+            const double K = tan (doublePi * splitFrequency / sampleRate);
+            
+            m_numSections = (poles + 1) / 2;
+            assert (m_numSections <= MaxSections);
+            
+            m_invert = (poles & 1) != 0;
+            
+            const int pairs = poles / 2;
+            for (int i = 0; i < pairs; ++i)
+            {
+                const double k = 2 * sin ((2 * i + 1) * doublePi / (2 * poles));
+                const double a0 = 1 + k * K + K * K;
+                const double a1 = 2 * (K * K - 1);
+                const double a2 = 1 - k * K + K * K;
+                m_lowPass[i].setup  (a0, a1, a2, K * K, 2 * K * K, K * K);
+                m_highPass[i].setup (a0, a1, a2, 1, -2, 1);
+                m_allPass[i].setup  (a0, a1, a2, a2, a1, a0);
+            }
+            
+            if (poles & 1)
+            {
+                const double a0 = 1 + K;
+                const double a1 = K - 1;
+                m_lowPass[pairs].setup  (a0, a1, 0, K, K, 0);
+                m_highPass[pairs].setup (a0, a1, 0, 1, -1, 0);
+                m_allPass[pairs].setup  (a0, a1, 0, a1, a0, 0);
+            }
+        }
+        
+        int m_numSections;
+        bool m_invert;
+        Section m_lowPass[MaxSections];
+        Section m_highPass[MaxSections];
+        Section m_allPass[MaxSections];
+    };
+    
+//------------------------------------------------------------------------------
+    
+    //
+    // Splits one input into up to MaxBands outputs, band 0 being the
+    // lowest. MaxOrder is the highest Linkwitz-Riley order (2, 4, 6, 8).
+    //
+    template <int MaxBands, int MaxOrder = 8, class StateType = DEFAULT_STATE>
+    class Crossover
+    {
+    public:
+        enum
+        {
+            MaxSplits = MaxBands - 1,
+            MaxSections = (MaxOrder / 2 + 1) / 2,
+            
+            // low and high pass twice per split, plus the compensation
+            MaxStates = MaxSplits * 4 * MaxSections
+                      + MaxSplits * (MaxSplits - 1) / 2 * MaxSections
+        };
+        
+        Crossover () : m_numBands (1)
+        {
+        }
+        
+        int getNumBands () const
+        {
+            return m_numBands;
+        }
+        
+        void reset ()
+        {
+            for (int i = 0; i < MaxStates; ++i)
+                m_states[i].reset ();
+        }
+        
+        // Split frequencies must be ascending, numBands - 1 of them
+        void setup (int order, int numBands, double sampleRate, const double* splitFrequencies)
+        {
+            assert (numBands >= 1 && numBands <= MaxBands);
+            
+            m_numBands = numBands;
+            for (int i = 0; i < numBands - 1; ++i)
+            {
+                assert (i == 0 || splitFrequencies[i] > splitFrequencies[i - 1]);
+                m_splits[i].setup (order, sampleRate, splitFrequencies[i]);
+            }
+        }
+        
+        // Writes getNumBands() outputs
+        template <typename Sample>
+        void filter (const Sample in, Sample* bands)
+        {
+            const int numSplits = m_numBands - 1;
+            StateType* state = m_states;
+            
+            double rest = in;
+            for (int i = 0; i < numSplits; ++i)
+            {
+                const Split <MaxSections>& split = m_splits[i];
+                const int n = split.m_numSections;
+                
+                double low = rest;
+                double high = rest;
+                for (int j = 0; j < n; ++j)
+                {
+                    low  = (state++)->process1 (low,  split.m_lowPass[j]);
+                    low  = (state++)->process1 (low,  split.m_lowPass[j]);
+                    high = (state++)->process1 (high, split.m_highPass[j]);
+                    high = (state++)->process1 (high, split.m_highPass[j]);
+                }
+                
+                bands[i] = static_cast<Sample> (low);
+                rest = split.m_invert ? -high : high;
+            }
+            
+            bands[numSplits] = static_cast<Sample> (rest);
+            
+            // phase compensation for the bands that left early
+            for (int i = 0; i < numSplits - 1; ++i)
+            {
+                double out = bands[i];
+                for (int k = i + 1; k < numSplits; ++k)
+                {
+                    const Split <MaxSections>& split = m_splits[k];
+                    for (int j = 0; j < split.m_numSections; ++j)
+                        out = (state++)->process1 (out, split.m_allPass[j]);
+                }
+                bands[i] = static_cast<Sample> (out);
+            }
+        }
+        
+    private:
+        int m_numBands;
+        Split <MaxSections> m_splits[MaxSplits > 0 ? MaxSplits : 1];
+        StateType m_states[MaxStates > 0 ? MaxStates : 1];
+    };
+    
+}
+
+#endif
@@ -0,0 +1,485 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_PARALLELFORM_H
+#define DSPFILTERS_PARALLELFORM_H
+
+/*
+ * Parallel form realization of a cascade
+ *
+ * In a cascade every stage waits for the output of the one before it, so
+ * the whole filter is one long chain of dependent multiply-adds. Expanding
+ * the transfer function into partial fractions turns it into a sum:
+ *
+ *   H(z) = Q(z) + sum over k of (b0k + b1k/z) / (1 + a1k/z + a2k/z^2)
+ *
+ * with a short FIR part Q(z), which is usually just a constant. Every
+ * section only sees the input, so they can all run at the same time, two
+ * per SSE2 or NEON register, four in process() with AVX2, see
+ * CpuFeatures.h. The denominators are those of the cascade's
+ * stages, only the numerators are new. They come from the residues at the
+ * poles, evaluated from the factored form of the cascade.
+ *
+ * Partial fractions get inaccurate for poles very close to each other,
+ * like those of high orders with very low cutoffs. So after setup() the
+ * impulse response is checked against the cascade's, and if it doesn't
+ * match, setup() returns false and the cascade should be used instead.
+ *
+ */
+
+namespace ParallelForm
+{
+    template <int MaxStages>
+    class Stages
+    {
+    public:
+        enum
+        {
+            MaxSections = (MaxStages + 3) & ~3,   // whole AVX2 registers
+            MaxTaps = 2 * MaxStages + 1
+        };
+        
+        Stages ()
+        : m_numStages (-1)
+        , m_valid (false)
+        , m_simdLevel (getSimdLevel ())
+        , m_numSections (0)
+        , m_numTaps (0)
+        {
+            reset ();
+        }
+        
+        // Converts the cascade, if the coefficients are different from
+        // before. Returns false if the parallel form can't stand in for it.
+        bool setup (const Biquad* stages, int numStages)
+        {
+            assert (numStages >= 0 && numStages <= MaxStages);
+            
+            m_simdLevel = getSimdLevel ();
+            
+            bool changed = (numStages != m_numStages);
+            for (int i = 0; i < numStages && ! changed; ++i)
+                changed = ! stages[i].hasSameCoefficients (m_stages[i]);
+            
+            if (changed)
+            {
+                m_numStages = numStages;
+                for (int i = 0; i < numStages; ++i)
+                    m_stages[i] = stages[i];
+                
+                m_valid = (numStages > 0) && design () && verify ();
+                reset ();
+            }
+            
+            return m_valid;
+        }
+        
+        bool setup (Cascade& cascade)
+        {
+            Biquad stages[MaxStages];
+            for (int i = 0; i < cascade.getNumStages (); ++i)
+                stages[i] = cascade[i];
+            
+            return setup (stages, cascade.getNumStages ());
+        }
+        
+        bool isValid () const
+        {
+            return m_valid;
+        }
+        
+        int getNumSections () const
+        {
+            return m_numSections;
+        }
+        
+        void reset ()
+        {
+            for (int i = 0; i < MaxSections; ++i)
+            {
+                m_s1[i] = 0;
+                m_s2[i] = 0;
+            }
+            
+            for (int i = 0; i < MaxTaps; ++i)
+                m_history[i] = 0;
+        }
+        
+        template <typename Sample>
+        inline Sample filter (const Sample in)
+        {
+            double out = filterTaps (in);
+            
+            // sections, transposed direct form II without b2
+#if DSPFILTERS_SSE2
+            const __m128d x = _mm_set1_pd (in);
+            __m128d sum = _mm_setzero_pd ();
+            
+            for (int i = 0; i < m_numSections; i += 2)
+            {
+                const __m128d s1 = _mm_loadu_pd (m_s1 + i);
+                const __m128d y = _mm_add_pd (_mm_mul_pd (_mm_loadu_pd (m_b0 + i), x), s1);
+                
+                _mm_storeu_pd (m_s1 + i, _mm_add_pd (_mm_sub_pd (_mm_mul_pd (_mm_loadu_pd (m_b1 + i), x),
+                                                                _mm_mul_pd (_mm_loadu_pd (m_a1 + i), y)),
+                                                    _mm_loadu_pd (m_s2 + i)));
+                _mm_storeu_pd (m_s2 + i, _mm_mul_pd (_mm_loadu_pd (m_a2 + i), y));
+                
+                sum = _mm_add_pd (sum, y);
+            }
+            
+            double pair[2];
+            _mm_storeu_pd (pair, sum);
+            out += pair[0] + pair[1];
+#elif DSPFILTERS_NEON
+            const float64x2_t x = vdupq_n_f64 (in);
+            float64x2_t sum = vdupq_n_f64 (0);
+            
+            for (int i = 0; i < m_numSections; i += 2)
+            {
+                const float64x2_t y = vfmaq_f64 (vld1q_f64 (m_s1 + i), vld1q_f64 (m_b0 + i), x);
+                
+                vst1q_f64 (m_s1 + i, vfmsq_f64 (vfmaq_f64 (vld1q_f64 (m_s2 + i), vld1q_f64 (m_b1 + i), x),
+                                                vld1q_f64 (m_a1 + i), y));
+                vst1q_f64 (m_s2 + i, vmulq_f64 (vld1q_f64 (m_a2 + i), y));
+                
+                sum = vaddq_f64 (sum, y);
+            }
+            
+            out += vaddvq_f64 (sum);
+#else
+            out += filterSections (in);
+#endif
+            
+            return static_cast<Sample> (out);
+        }
+        
+        // A block at a time, on the widest registers getSimdLevel() had
+        // at the last setup(). filter() always sticks to SSE2 or NEON.
+        template <typename Sample>
+        void process (int numSamples, Sample* dest)
+        {
+            switch (m_simdLevel)
+            {
+#if DSPFILTERS_DISPATCH
+                case simdAVX512:    // measured no faster, the states go
+                case simdAVX2:      // through memory on every sample
+                    processAVX2 (numSamples, dest);
+                    break;
+#endif
+                case simdScalar:
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        const double in = dest[i];
+                        dest[i] = static_cast<Sample> (filterTaps (in) + filterSections (in));
+                    }
+                    break;
+                    
+                default:
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[i] = filter (dest[i]);
+                    break;
+            }
+        }
+        
+    private:
+        inline double filterTaps (const double in)
+        {
+            double out = 0;
+            
+            for (int i = m_numTaps; --i > 0;)
+                m_history[i] = m_history[i - 1];
+            m_history[0] = in;
+            for (int i = 0; i < m_numTaps; ++i)
+                out += m_taps[i] * m_history[i];
+            
+            return out;
+        }
+        
+        inline double filterSections (const double in)
+        {
+            double out = 0;
+            
+            for (int i = 0; i < m_numSections; ++i)
+            {
+                const double y = m_b0[i] * in + m_s1[i];
+                m_s1[i] = m_b1[i] * in - m_a1[i] * y + m_s2[i];
+                m_s2[i] = m_a2[i] * y;
+                out += y;
+            }
+            
+            return out;
+        }
+        
+#if DSPFILTERS_DISPATCH
+        // The sections past m_numSections are all zero, so the wider
+        // registers can simply run over them.
+        template <typename Sample>
+        DSPFILTERS_TARGET_AVX2
+        void processAVX2 (int numSamples, Sample* dest)
+        {
+            const int numSections = (m_numSections + 3) & ~3;
+            
+            for (int n = 0; n < numSamples; ++n)
+            {
+                const double in = dest[n];
+                const __m256d x = _mm256_set1_pd (in);
+                __m256d sum = _mm256_setzero_pd ();
+                
+                for (int i = 0; i < numSections; i += 4)
+                {
+                    const __m256d y = _mm256_fmadd_pd (_mm256_loadu_pd (m_b0 + i), x, _mm256_loadu_pd (m_s1 + i));
+                    
+                    _mm256_storeu_pd (m_s1 + i, _mm256_fnmadd_pd (_mm256_loadu_pd (m_a1 + i), y,
+                                                                  _mm256_fmadd_pd (_mm256_loadu_pd (m_b1 + i), x,
+                                                                                   _mm256_loadu_pd (m_s2 + i))));
+                    _mm256_storeu_pd (m_s2 + i, _mm256_mul_pd (_mm256_loadu_pd (m_a2 + i), y));
+                    
+                    sum = _mm256_add_pd (sum, y);
+                }
+                
+                const __m128d pair = _mm_add_pd (_mm256_castpd256_pd128 (sum), _mm256_extractf128_pd (sum, 1));
+                const double out = _mm_cvtsd_f64 (_mm_add_sd (pair, _mm_unpackhi_pd (pair, pair)));
+                
+                dest[n] = static_cast<Sample> (filterTaps (in) + out);
+            }
+        }
+#endif
+        
+        bool design ()
+        {
+            // poles of every stage, in z
+            complex_t poles[2 * MaxStages];
+            int stagePoles[MaxStages] = {};
+            int numPoles = 0;
+            
+            for (int k = 0; k < m_numStages; ++k)
+            {
+                const double a1 = m_stages[k].m_a1;
+                const double a2 = m_stages[k].m_a2;
+                
+                if (a2 != 0)
+                {
+                    const complex_t c = std::sqrt (complex_t (a1 * a1 - 4 * a2, 0));
+                    poles[numPoles++] = (-a1 + c) / 2.;
+                    poles[numPoles++] = (-a1 - c) / 2.;
+                    stagePoles[k] = 2;
+                }
+                else if (a1 != 0)
+                {
+                    poles[numPoles++] = -a1;
+                    stagePoles[k] = 1;
+                }
+                else
+                {
+                    stagePoles[k] = 0;
+                }
+            }
+            
+            // FIR part, the quotient of numerator and denominator in 1/z
+            double num[MaxTaps];
+            double den[MaxTaps];
+            int numDegree = 0;
+            int denDegree = 0;
+            num[0] = 1;
+            den[0] = 1;
+            
+            for (int k = 0; k < m_numStages; ++k)
+            {
+                const Biquad& s = m_stages[k];
+                numDegree = multiply (num, numDegree, s.m_b0, s.m_b1, s.m_b2);
+                denDegree = multiply (den, denDegree, 1, s.m_a1, s.m_a2);
+            }
+            
+            while (numDegree > 0 && num[numDegree] == 0)
+                --numDegree;
+            while (denDegree > 0 && den[denDegree] == 0)
+                --denDegree;
+            
+            assert (denDegree == numPoles);
+            
+            m_numTaps = std::max (0, numDegree - denDegree + 1);
+            for (int i = m_numTaps; --i >= 0;)
+            {
+                m_taps[i] = num[i + denDegree] / den[denDegree];
+                for (int j = 0; j <= denDegree; ++j)
+                    num[i + j] -= m_taps[i] * den[j];
+            }
+            
+            // residues, straight from the factored form
+            complex_t residues[2 * MaxStages];
+            for (int i = 0; i < numPoles; ++i)
+            {
+                const complex_t q = 1. / poles[i];
+                
+                complex_t n = 1;
+                for (int k = 0; k < m_numStages; ++k)
+                {
+                    const Biquad& s = m_stages[k];
+                    n *= s.m_b0 + q * (s.m_b1 + q * s.m_b2);
+                }
+                
+                complex_t d = 1;
+                for (int j = 0; j < numPoles; ++j)
+                    if (j != i)
+                        d *= 1. - poles[j] * q;
+                
+                if (std::abs (d) == 0)
+                    return false;
+                
+                residues[i] = n / d;
+            }
+            
+            // sections, stage by stage, lone real poles get paired up
+            m_numSections = 0;
+            int single = -1;
+            
+            for (int k = 0, i = 0; k < m_numStages; i += stagePoles[k++])
+            {
+                if (stagePoles[k] == 2)
+                {
+                    addSection (poles[i], residues[i], poles[i + 1], residues[i + 1]);
+                }
+                else if (stagePoles[k] == 1)
+                {
+                    if (single < 0)
+                    {
+                        single = i;
+                    }
+                    else
+                    {
+                        addSection (poles[single], residues[single], poles[i], residues[i]);
+                        single = -1;
+                    }
+                }
+            }
+            
+            if (single >= 0)
+                addSection (poles[single], residues[single], 0, 0);
+            
+            while (m_numSections & 1)
+                addSection (0, 0, 0, 0);
+            
+            for (int i = m_numSections; i < MaxSections; ++i)
+            {
+                m_b0[i] = 0;
+                m_b1[i] = 0;
+                m_a1[i] = 0;
+                m_a2[i] = 0;
+            }
+            
+            return true;
+        }
+        
+        // r1/(1-p1/z) + r2/(1-p2/z), the pairs are either conjugate or real
+        void addSection (complex_t p1, complex_t r1, complex_t p2, complex_t r2)
+        {
+            assert (m_numSections < MaxSections);
+            
+            const int i = m_numSections++;
+            m_b0[i] = (r1 + r2).real ();
+            m_b1[i] = -(r1 * p2 + r2 * p1).real ();
+            m_a1[i] = -(p1 + p2).real ();
+            m_a2[i] = -(p1 * p2).real ();   // negated, saves a subtraction
+        }
+        
+        // poly *= b0 + b1/z + b2/z^2
+        static int multiply (double* poly, int degree, double b0, double b1, double b2)
+        {
+            poly[degree + 1] = 0;
+            poly[degree + 2] = 0;
+            
+            for (int i = degree + 2; i >= 0; --i)
+            {
+                double v = b0 * poly[i];
+                if (i >= 1) v += b1 * poly[i - 1];
+                if (i >= 2) v += b2 * poly[i - 2];
+                poly[i] = v;
+            }
+            
+            return degree + 2;
+        }
+        
+        // Compares the first few hundred samples of the impulse response
+        bool verify ()
+        {
+            reset ();
+            
+            DirectFormII states[MaxStages];
+            double peak = 0;
+            double error = 0;
+            
+            for (int n = 0; n < 512; ++n)
+            {
+                double expected = (n == 0) ? 1 : 0;
+                for (int k = 0; k < m_numStages; ++k)
+                    expected = states[k].process1 (expected, m_stages[k]);
+                
+                const double actual = filter ((n == 0) ? 1. : 0.);
+                
+                peak = std::max (peak, std::abs (expected));
+                error = std::max (error, std::abs (actual - expected));
+            }
+            
+            return error <= 1e-7 * peak;
+        }
+        
+        int m_numStages;
+        Biquad m_stages[MaxStages];
+        bool m_valid;
+        int m_simdLevel;
+        
+        int m_numSections;
+        double m_b0[MaxSections];
+        double m_b1[MaxSections];
+        double m_a1[MaxSections];
+        double m_a2[MaxSections];
+        double m_s1[MaxSections];
+        double m_s2[MaxSections];
+        
+        int m_numTaps;
+        double m_taps[MaxTaps];
+        double m_history[MaxTaps];
+    };
+}
+
+#endif
@@ -96,6 +96,43 @@ public:
     double getB1 () const { return m_b1*m_a0; }
     double getB2 () const { return m_b2*m_a0; }
     
+    // Shape of the numerator, see StructuredKernel.h. Low pass, high pass
+    // and band stop stages all have symmetric numerators, b2 = b0. Zeros
+    // placed on the unit circle come out a rounding error off, so b2 only
+    // has to be close to b0.
+    enum Structure
+    {
+        generalStructure,
+        onePoleStructure,           // a2 = b2 = 0
+        lowPassStructure,           // b = b0 * (1, 2, 1)
+        highPassStructure,          // b = b0 * (1, -2, 1)
+        symmetricStructure          // b2 = b0
+    };
+    
+    int getStructure () const
+    {
+        if (m_a2 == 0 && m_b2 == 0)
+            return onePoleStructure;
+        
+        if (std::abs (m_b2 - m_b0) > 1e-12 * std::abs (m_b0))
+            return generalStructure;
+        
+        if (m_b1 == 2 * m_b0)
+            return lowPassStructure;
+        
+        if (m_b1 == -2 * m_b0)
+            return highPassStructure;
+        
+        return symmetricStructure;
+    }
+    
+    // True if both would filter exactly alike
+    bool hasSameCoefficients (const BiquadBase& other) const
+    {
+        return m_a1 == other.m_a1 && m_a2 == other.m_a2 && m_b0 == other.m_b0 &&
+               m_b1 == other.m_b1 && m_b2 == other.m_b2;
+    }
+    
     // Process a sample in the given form
     template <class StateType, typename Sample>
     Sample filter(Sample s, StateType& state) const
@@ -0,0 +1,492 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_BLOCKKERNEL_H
+#define DSPFILTERS_BLOCKKERNEL_H
+
+/*
+ * Block state space kernel for a single channel.
+ *
+ * A biquad's recursion only lets one sample through at a time, which
+ * leaves the SIMD lanes of the CPU idle. But N samples ahead, the state
+ * and the outputs of a biquad are just linear combinations of the state
+ * now and the N inputs in between:
+ *
+ *   y[0..N-1] = O * s + H * x[0..N-1]
+ *   s'        = P * s + K * x[0..N-1]
+ *
+ * with H the lower triangle of the impulse response, O the response to
+ * the state, P the state transition over N samples and K the state the
+ * inputs leave behind. Those are matrix-vector products the SIMD lanes
+ * can share, and only the 2x2 state transition is left in the recursion.
+ *
+ * The samples are converted to double a tile at a time, and every stage
+ * runs over the whole tile before the next one starts, so the matrices
+ * and the state can stay in registers. The tile should sit comfortably
+ * in the L1 cache. Small tiles measured best, the per tile overhead is
+ * tiny next to the stages going through L2 with the large ones.
+ *
+ * The matrices are found by running the regular state type over unit
+ * states and unit impulses, so every state type with getValues() and
+ * setValues() works, and the state carries over to and from it exactly.
+ * They are only rebuilt when the coefficients change.
+ *
+ * With two values of state, the stages run on SSE2, NEON or AVX2 with
+ * FMA, whichever getSimdLevel() picks, see CpuFeatures.h. The blocks of
+ * four samples fill an AVX2 register, AVX-512 has nothing to add there.
+ *
+ */
+
+template <class StateType, int BlockSize = 4>
+class BlockKernel
+{
+public:
+    enum
+    {
+        NumValues = StateType::numValues,
+        DefaultTileSize = 32 * BlockSize
+    };
+    
+    BlockKernel ()
+    : m_simdLevel (simdAuto)
+    , m_processStage (&processStageScalar)
+    {
+        setTileSize (DefaultTileSize);
+    }
+    
+    // Rounded up to whole blocks. This allocates, so not from the audio thread.
+    void setTileSize (int samples)
+    {
+        assert (samples > 0);
+        m_tile.resize ((samples + BlockSize - 1) / BlockSize * BlockSize);
+    }
+    
+    int getTileSize () const
+    {
+        return static_cast<int> (m_tile.size ());
+    }
+    
+    template <class StageType, typename Sample>
+    void process (int numSamples, Sample* dest,
+                  const StageType* stages, StateType* states, int numStages)
+    {
+        process (numSamples, dest, dest, stages, states, numStages);
+    }
+    
+    // Reads src and writes dest, which may be the same. The samples go
+    // through the tile either way, so this costs nothing extra.
+    template <class StageType, typename Sample>
+    void process (int numSamples, const Sample* src, Sample* dest,
+                  const StageType* stages, StateType* states, int numStages)
+    {
+        prepare (stages, numStages);
+        
+        for (int i = 0; i < numStages; ++i)
+        {
+            prepareState (states[i], stages[i]);
+            states[i].getValues (&m_values[i * NumValues]);
+        }
+        
+        const int numBlockSamples = numSamples - numSamples % BlockSize;
+        
+        const int tileSize = getTileSize ();
+        double* const tile = &m_tile[0];
+        
+        for (int start = 0; start < numBlockSamples; start += tileSize)
+        {
+            const int length = std::min (tileSize, numBlockSamples - start);
+            const Sample* input = src + start;
+            Sample* data = dest + start;
+            
+            for (int i = 0; i < length; ++i)
+                tile[i] = input[i];
+            
+            for (int stage = 0; stage < numStages; ++stage)
+                m_processStage (m_matrices[stage], &m_values[stage * NumValues],
+                              tile, length / BlockSize);
+            
+            for (int i = 0; i < length; ++i)
+                data[i] = static_cast<Sample> (tile[i]);
+        }
+        
+        for (int i = 0; i < numStages; ++i)
+            states[i].setValues (&m_values[i * NumValues]);
+        
+        // the rest doesn't fill a block
+        for (int i = numBlockSamples; i < numSamples; ++i)
+        {
+            double out = src[i];
+            for (int stage = 0; stage < numStages; ++stage)
+                out = states[stage].process1 (out, stages[stage]);
+            dest[i] = static_cast<Sample> (out);
+        }
+    }
+    
+private:
+    struct Matrices
+    {
+        double h[BlockSize * BlockSize];    // column k = response to x[k]
+        double o[NumValues * BlockSize];    // column j = response to state j
+        double p[NumValues * NumValues];    // column j = state j after the block
+        double k[BlockSize * NumValues];    // column k = state x[k] leaves behind
+    };
+    
+    typedef void (*StageFunction) (const Matrices&, double*, double*, int);
+    
+    static StageFunction selectStage (int level)
+    {
+        if (NumValues != 2 || (BlockSize & 1) != 0)
+            return &processStageScalar;
+        
+        switch (level)
+        {
+#if DSPFILTERS_DISPATCH
+            case simdAVX512:
+            case simdAVX2:
+                if ((BlockSize & 3) == 0)
+                    return &processStageAVX2;
+                return &processStageSSE2;
+#endif
+#if DSPFILTERS_SSE2
+            case simdSSE2:
+                return &processStageSSE2;
+#endif
+#if DSPFILTERS_NEON
+            case simdNEON:
+                return &processStageNEON;
+#endif
+            default:
+                return &processStageScalar;
+        }
+    }
+    
+    static void processStageScalar (const Matrices& m, double* values, double* x, int numBlocks)
+    {
+        double s[NumValues];
+        for (int r = 0; r < NumValues; ++r)
+            s[r] = values[r];
+        
+        for (int block = 0; block < numBlocks; ++block, x += BlockSize)
+        {
+            double y[BlockSize];
+            double next[NumValues];
+            
+            for (int i = 0; i < BlockSize; ++i)
+                y[i] = 0;
+            for (int r = 0; r < NumValues; ++r)
+                next[r] = 0;
+            
+            for (int j = 0; j < NumValues; ++j)
+            {
+                for (int i = 0; i < BlockSize; ++i)
+                    y[i] += m.o[j * BlockSize + i] * s[j];
+                for (int r = 0; r < NumValues; ++r)
+                    next[r] += m.p[j * NumValues + r] * s[j];
+            }
+            
+            for (int c = 0; c < BlockSize; ++c)
+            {
+                for (int i = c; i < BlockSize; ++i)
+                    y[i] += m.h[c * BlockSize + i] * x[c];
+                for (int r = 0; r < NumValues; ++r)
+                    next[r] += m.k[c * NumValues + r] * x[c];
+            }
+            
+            for (int i = 0; i < BlockSize; ++i)
+                x[i] = y[i];
+            for (int r = 0; r < NumValues; ++r)
+                s[r] = next[r];
+        }
+        
+        for (int r = 0; r < NumValues; ++r)
+            values[r] = s[r];
+    }
+    
+#if DSPFILTERS_SSE2
+    // Two samples per register, the matrices are loaded once per tile
+    static void processStageSSE2 (const Matrices& m, double* values, double* x, int numBlocks)
+    {
+        enum { Pairs = BlockSize / 2 };
+        
+        __m128d h[BlockSize][Pairs];
+        __m128d o0[Pairs];
+        __m128d o1[Pairs];
+        __m128d k[BlockSize];
+        const __m128d p0 = _mm_loadu_pd (m.p);
+        const __m128d p1 = _mm_loadu_pd (m.p + 2);
+        
+        for (int i = 0; i < Pairs; ++i)
+        {
+            o0[i] = _mm_loadu_pd (m.o + 2 * i);
+            o1[i] = _mm_loadu_pd (m.o + BlockSize + 2 * i);
+        }
+        
+        for (int c = 0; c < BlockSize; ++c)
+        {
+            k[c] = _mm_loadu_pd (m.k + c * 2);
+            for (int i = 0; i < Pairs; ++i)
+                h[c][i] = _mm_loadu_pd (m.h + c * BlockSize + 2 * i);
+        }
+        
+        __m128d s = _mm_loadu_pd (values);
+        
+        for (int block = 0; block < numBlocks; ++block, x += BlockSize)
+        {
+            const __m128d s0 = _mm_unpacklo_pd (s, s);
+            const __m128d s1 = _mm_unpackhi_pd (s, s);
+            
+            __m128d y[Pairs];
+            for (int i = 0; i < Pairs; ++i)
+                y[i] = _mm_add_pd (_mm_mul_pd (o0[i], s0), _mm_mul_pd (o1[i], s1));
+            
+            __m128d next = _mm_add_pd (_mm_mul_pd (p0, s0), _mm_mul_pd (p1, s1));
+            
+            for (int c = 0; c < Pairs; ++c)
+            {
+                const __m128d xx = _mm_loadu_pd (x + 2 * c);
+                const __m128d x0 = _mm_unpacklo_pd (xx, xx);
+                const __m128d x1 = _mm_unpackhi_pd (xx, xx);
+                
+                // H is lower triangular, pairs above the diagonal are zero
+                for (int i = c; i < Pairs; ++i)
+                    y[i] = _mm_add_pd (y[i], _mm_add_pd (_mm_mul_pd (h[2 * c][i], x0),
+                                                         _mm_mul_pd (h[2 * c + 1][i], x1)));
+                
+                next = _mm_add_pd (next, _mm_add_pd (_mm_mul_pd (k[2 * c], x0),
+                                                     _mm_mul_pd (k[2 * c + 1], x1)));
+            }
+            
+            for (int i = 0; i < Pairs; ++i)
+                _mm_storeu_pd (x + 2 * i, y[i]);
+            
+            s = next;
+        }
+        
+        _mm_storeu_pd (values, s);
+    }
+#endif
+    
+#if DSPFILTERS_DISPATCH
+    // Four samples per register, with fused multiply-adds. The parts that
+    // only depend on the inputs come first, so little is left between one
+    // block's state and the next.
+    DSPFILTERS_TARGET_AVX2
+    static void processStageAVX2 (const Matrices& m, double* values, double* x, int numBlocks)
+    {
+        enum { Quads = (BlockSize + 3) / 4 };
+        
+        __m256d h[BlockSize][Quads];
+        __m256d o0[Quads];
+        __m256d o1[Quads];
+        __m128d k[BlockSize];
+        const __m128d p0 = _mm_loadu_pd (m.p);
+        const __m128d p1 = _mm_loadu_pd (m.p + 2);
+        
+        for (int i = 0; i < Quads; ++i)
+        {
+            o0[i] = _mm256_loadu_pd (m.o + 4 * i);
+            o1[i] = _mm256_loadu_pd (m.o + BlockSize + 4 * i);
+        }
+        
+        for (int c = 0; c < BlockSize; ++c)
+        {
+            k[c] = _mm_loadu_pd (m.k + c * 2);
+            for (int i = 0; i < Quads; ++i)
+                h[c][i] = _mm256_loadu_pd (m.h + c * BlockSize + 4 * i);
+        }
+        
+        __m128d s = _mm_loadu_pd (values);
+        
+        for (int block = 0; block < numBlocks; ++block, x += BlockSize)
+        {
+            __m256d y[Quads];
+            for (int i = 0; i < Quads; ++i)
+                y[i] = _mm256_setzero_pd ();
+            
+            __m128d next = _mm_setzero_pd ();
+            
+            for (int c = 0; c < BlockSize; ++c)
+            {
+                const __m256d xc = _mm256_broadcast_sd (x + c);
+                
+                // H is lower triangular, quads above the diagonal are zero
+                for (int i = c / 4; i < Quads; ++i)
+                    y[i] = _mm256_fmadd_pd (h[c][i], xc, y[i]);
+                
+                next = _mm_fmadd_pd (k[c], _mm256_castpd256_pd128 (xc), next);
+            }
+            
+            const __m128d s0 = _mm_unpacklo_pd (s, s);
+            const __m128d s1 = _mm_unpackhi_pd (s, s);
+            const __m256d ss0 = _mm256_broadcastsd_pd (s0);
+            const __m256d ss1 = _mm256_broadcastsd_pd (s1);
+            
+            for (int i = 0; i < Quads; ++i)
+                _mm256_storeu_pd (x + 4 * i, _mm256_fmadd_pd (o1[i], ss1, _mm256_fmadd_pd (o0[i], ss0, y[i])));
+            
+            s = _mm_fmadd_pd (p1, s1, _mm_fmadd_pd (p0, s0, next));
+        }
+        
+        _mm_storeu_pd (values, s);
+    }
+#endif
+    
+#if DSPFILTERS_NEON
+    // Like SSE2, two samples per register, but with fused multiply-adds
+    static void processStageNEON (const Matrices& m, double* values, double* x, int numBlocks)
+    {
+        enum { Pairs = BlockSize / 2 };
+        
+        float64x2_t h[BlockSize][Pairs];
+        float64x2_t o0[Pairs];
+        float64x2_t o1[Pairs];
+        float64x2_t k[BlockSize];
+        const float64x2_t p0 = vld1q_f64 (m.p);
+        const float64x2_t p1 = vld1q_f64 (m.p + 2);
+        
+        for (int i = 0; i < Pairs; ++i)
+        {
+            o0[i] = vld1q_f64 (m.o + 2 * i);
+            o1[i] = vld1q_f64 (m.o + BlockSize + 2 * i);
+        }
+        
+        for (int c = 0; c < BlockSize; ++c)
+        {
+            k[c] = vld1q_f64 (m.k + c * 2);
+            for (int i = 0; i < Pairs; ++i)
+                h[c][i] = vld1q_f64 (m.h + c * BlockSize + 2 * i);
+        }
+        
+        float64x2_t s = vld1q_f64 (values);
+        
+        for (int block = 0; block < numBlocks; ++block, x += BlockSize)
+        {
+            const float64x2_t s0 = vdupq_laneq_f64 (s, 0);
+            const float64x2_t s1 = vdupq_laneq_f64 (s, 1);
+            
+            float64x2_t y[Pairs];
+            for (int i = 0; i < Pairs; ++i)
+                y[i] = vfmaq_f64 (vmulq_f64 (o0[i], s0), o1[i], s1);
+            
+            float64x2_t next = vfmaq_f64 (vmulq_f64 (p0, s0), p1, s1);
+            
+            for (int c = 0; c < BlockSize; ++c)
+            {
+                const float64x2_t xc = vdupq_n_f64 (x[c]);
+                
+                for (int i = c / 2; i < Pairs; ++i)
+                    y[i] = vfmaq_f64 (y[i], h[c][i], xc);
+                
+                next = vfmaq_f64 (next, k[c], xc);
+            }
+            
+            for (int i = 0; i < Pairs; ++i)
+                vst1q_f64 (x + 2 * i, y[i]);
+            
+            s = next;
+        }
+        
+        vst1q_f64 (values, s);
+    }
+#endif
+    
+    template <class StageType>
+    void prepare (const StageType* stages, int numStages)
+    {
+        const int level = getSimdLevel ();
+        if (level != m_simdLevel)
+        {
+            m_simdLevel = level;
+            m_processStage = selectStage (level);
+        }
+        
+        bool changed = (static_cast<int> (m_coefficients.size ()) != numStages);
+        for (int i = 0; i < numStages && ! changed; ++i)
+            changed = ! stages[i].hasSameCoefficients (m_coefficients[i]);
+        
+        if (! changed)
+            return;
+        
+        m_coefficients.assign (stages, stages + numStages);
+        m_matrices.resize (numStages);
+        m_values.resize (numStages * NumValues);
+        
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            const StageType& s = stages[stage];
+            Matrices& m = m_matrices[stage];
+            double values[NumValues];
+            
+            for (int j = 0; j < NumValues; ++j)
+            {
+                StateType state;
+                for (int r = 0; r < NumValues; ++r)
+                    values[r] = (r == j) ? 1 : 0;
+                prepareState (state, s);
+                state.setValues (values);
+                
+                for (int i = 0; i < BlockSize; ++i)
+                    m.o[j * BlockSize + i] = state.process1 (0., s);
+                
+                state.getValues (&m.p[j * NumValues]);
+            }
+            
+            for (int c = 0; c < BlockSize; ++c)
+            {
+                StateType state;
+                for (int i = 0; i < BlockSize; ++i)
+                    m.h[c * BlockSize + i] = state.process1 ((i == c) ? 1. : 0., s);
+                
+                state.getValues (&m.k[c * NumValues]);
+            }
+        }
+    }
+    
+    std::vector<BiquadBase> m_coefficients;
+    std::vector<Matrices> m_matrices;
+    std::vector<double> m_values;
+    std::vector<double> m_tile;
+    int m_simdLevel;
+    StageFunction m_processStage;
+};
+
+#endif
@@ -38,6 +38,28 @@ THE SOFTWARE.
 
 /*
  * Holds coefficients for a cascade of second order sections.
+ *
+ * By default the stages follow the layout, and the whole normalization
+ * gain sits on the first stage. That's fine in double, but in float or
+ * fixed point a high order Elliptic or Chebyshev can peak far above the
+ * input inside the cascade, or lose its quiet parts in the noise of the
+ * stages after a low gain one. setStageOptimization() realizes the layout
+ * the way the textbooks do instead:
+ *
+ *  - Pairing: the poles closest to the unit circle take the nearest zeros
+ *    first, so the zeros can cancel as much of the peak as possible.
+ *
+ *  - Ordering: peak scaling puts the most peaked stage last, so it can't
+ *    drive the ones after it, energy scaling puts it first, where its
+ *    noise is filtered by the rest of the cascade.
+ *
+ *  - Gain: every stage but the last is scaled so the response from the
+ *    input to its output has a peak (L-infinity) or energy (L2) of one.
+ *    The last stage takes whatever is left to hit the normalization.
+ *
+ * The response of the cascade stays the same up to rounding. Gliding from
+ * one design to another can swap two stages of similar peak, which the
+ * ramps survive, they stay stable, but not without a small transient.
  */
 
 // Factored implementation to reduce template instantiations
@@ -114,9 +136,27 @@ public:
         return vpz;
     }
     
+    enum StageOptimization
+    {
+        stagesAsLaidOut,            // layout order, all gain on the first stage
+        stagesPeakScaled,           // most peaked stage last, L-infinity scaling
+        stagesEnergyScaled          // most peaked stage first, L2 scaling
+    };
+    
+    // Takes effect the next time the filter is set up
+    void setStageOptimization (int optimization)
+    {
+        m_optimization = optimization;
+    }
+    
+    int getStageOptimization () const
+    {
+        return m_optimization;
+    }
+    
 protected:
     
-    Cascade ()  : m_numStages(0),m_maxStages(0),m_stageArray(0) {}
+    Cascade ()  : m_numStages(0),m_maxStages(0),m_stageArray(0),m_optimization(stagesAsLaidOut) {}
     
     void setCascadeStorage (const Storage& storage)
     {
@@ -139,6 +179,12 @@ protected:
         m_numStages = (numPoles + 1)/ 2;
         assert (m_numStages <= m_maxStages);
         
+        if (m_optimization != stagesAsLaidOut && m_numStages <= maxOptimizedStages)
+        {
+            setOptimizedLayout (proto);
+            return;
+        }
+        
         Biquad* stage = m_stageArray;
         for (int i = 0; i < m_numStages; ++i, ++stage)
             stage->setPoleZeroPair (proto[i]);
@@ -148,9 +194,135 @@ protected:
     }
     
 private:
+    // Scratch space lives on the stack, setup can run on the audio thread
+    enum
+    {
+        maxOptimizedStages = 64,
+        numGridPoints = 256
+    };
+    
+    static double getRadius (const ComplexPair& poles)
+    {
+        return std::max (std::abs (poles.first), std::abs (poles.second));
+    }
+    
+    static double getDistance (const ComplexPair& poles, const ComplexPair& zeros)
+    {
+        return std::min (std::abs (poles.first - zeros.first),
+                         std::abs (poles.first - zeros.second));
+    }
+    
+    void setOptimizedLayout (const LayoutBase& proto)
+    {
+        // A single pole stage always stays last
+        const int numPairs = proto.getNumPoles() / 2;
+        
+        int order[maxOptimizedStages];
+        int zeroOf[maxOptimizedStages];
+        bool taken[maxOptimizedStages];
+        
+        // Poles by distance from the unit circle, closest first
+        for (int i = 0; i < numPairs; ++i)
+        {
+            order[i] = i;
+            taken[i] = false;
+        }
+        
+        for (int i = 1; i < numPairs; ++i)
+            for (int j = i; j > 0 && getRadius (proto[order[j]].poles) >
+                                     getRadius (proto[order[j - 1]].poles); --j)
+                std::swap (order[j], order[j - 1]);
+        
+        for (int i = 0; i < numPairs; ++i)
+        {
+            const ComplexPair& poles = proto[order[i]].poles;
+            
+            int nearest = -1;
+            for (int j = 0; j < numPairs; ++j)
+                if (! taken[j] && (nearest < 0 || getDistance (poles, proto[j].zeros) <
+                                                  getDistance (poles, proto[nearest].zeros)))
+                    nearest = j;
+            
+            taken[nearest] = true;
+            zeroOf[order[i]] = nearest;
+        }
+        
+        // Peak scaling runs them the other way round, most peaked last
+        if (m_optimization == stagesPeakScaled)
+            std::reverse (order, order + numPairs);
+        
+        Biquad* stage = m_stageArray;
+        for (int i = 0; i < numPairs; ++i, ++stage)
+        {
+            const PoleZeroPair& p = proto[order[i]];
+            const PoleZeroPair& z = proto[zeroOf[order[i]]];
+            stage->setPoleZeroPair (PoleZeroPair (p.poles.first, z.zeros.first,
+                                                  p.poles.second, z.zeros.second));
+        }
+        
+        if (numPairs < m_numStages)
+            stage->setPoleZeroPair (proto[numPairs]);
+        
+        distributeGain (proto.getNormalGain() /
+                        std::abs (response (proto.getNormalW() / (2 * doublePi))));
+    }
+    
+    // Scales every stage but the last to a peak or energy of one from the
+    // input to its output. The peaks of narrow stages fall between the
+    // grid points, so the peak is also looked for at all pole angles.
+    void distributeGain (double totalGain)
+    {
+        const int numUniform = numGridPoints;
+        int numPoints = numUniform;
+        
+        double frequency[numGridPoints + maxOptimizedStages];
+        double magnitude[numGridPoints + maxOptimizedStages];
+        
+        for (int i = 0; i < numUniform; ++i)
+            frequency[i] = 0.5 * i / (numUniform - 1);
+        
+        if (m_optimization == stagesPeakScaled)
+            for (int i = 0; i < m_numStages; ++i)
+                frequency[numPoints++] = std::abs (std::arg (
+                    BiquadPoleState (m_stageArray[i]).poles.first)) / (2 * doublePi);
+        
+        for (int i = 0; i < numPoints; ++i)
+            magnitude[i] = 1;
+        
+        double applied = 1;
+        for (int k = 0; k < m_numStages - 1; ++k)
+        {
+            double norm = 0;
+            for (int i = 0; i < numPoints; ++i)
+            {
+                magnitude[i] *= std::norm (m_stageArray[k].response (frequency[i]));
+                
+                if (m_optimization == stagesPeakScaled)
+                    norm = std::max (norm, magnitude[i]);
+                else if (i < numUniform)
+                    norm += ((i == 0 || i == numUniform - 1) ? 0.5 : 1.) * magnitude[i];
+            }
+            
+            if (m_optimization != stagesPeakScaled)
+                norm /= numUniform - 1;
+            
+            norm = std::sqrt (norm);
+            if (! (norm > 0) || is_nan (norm) || norm > 1e300)
+                continue;
+            
+            // the gain through stage k becomes 1 / norm
+            const double scale = 1 / (norm * applied);
+            m_stageArray[k].applyScale (scale);
+            applied *= scale;
+        }
+        
+        m_stageArray[m_numStages - 1].applyScale (totalGain / applied);
+    }
+    
     int m_numStages;
     int m_maxStages;
     Stage* m_stageArray;
+    int m_optimization;
 };
 
 //------------------------------------------------------------------------------
@@ -160,33 +332,284 @@ template <int MaxStages,class StateType>
 class CascadeStages
 {
 public:
+    CascadeStages () : m_meters (0), m_glideRemaining (0)
+    {
+    }
+    
+    // The meter pointer is atomic, which takes the implicit copies away
+    CascadeStages (const CascadeStages& other)
+    {
+        *this = other;
+    }
+    
+    CascadeStages& operator= (const CascadeStages& other)
+    {
+        for (int i = 0; i < MaxStages; ++i)
+        {
+            m_stages[i] = other.m_stages[i];
+            m_states[i] = other.m_states[i];
+            m_ramps[i] = other.m_ramps[i];
+        }
+        m_block = other.m_block;
+        m_structured = other.m_structured;
+        m_meters.store (other.getMeters (), std::memory_order_release);
+        m_glideRemaining = other.m_glideRemaining;
+        return *this;
+    }
+    
     void reset ()
     {
         StateType* state = m_states;
-        for (int i = MaxStages; --i >= 0; ++state)
+        BiquadRamp* ramp = m_ramps;
+        for (int i = MaxStages; --i >= 0; ++state, ++ramp)
+        {
             state->reset();
+            ramp->reset();
+        }
+        m_glideRemaining = 0;
+    }
+    
+    // Modulation without resetting the states. Call beginGlide() before
+    // redesigning the cascade and endGlide() afterwards, then the stage
+    // coefficients travel to the new design over the next numSamples.
+    void beginGlide ()
+    {
+        for (int i = 0; i < MaxStages; ++i)
+            m_ramps[i].begin (m_stages[i]);
+    }
+    
+    void endGlide (int numSamples)
+    {
+        for (int i = 0; i < MaxStages; ++i)
+            m_ramps[i].end (m_stages[i], numSamples);
+        
+        // all ramps run the same length, see BiquadRamp::end()
+        m_glideRemaining = (numSamples > 1) ? numSamples : 0;
+    }
+    
+    // Meters stage i into meters[i], see StageMeter.h. The array must
+    // hold MaxStages meters and outlive the metering, pass 0 to stop.
+    // While metering, filter() publishes on every sample and filterBlock()
+    // once per block, running the stages a sample at a time. Safe to call
+    // from any thread while the audio thread filters, each call to filter()
+    // or filterBlock() picks up the pointer once. Stopping doesn't wait for
+    // a call already running though, so keep the array alive until the
+    // next block has gone through.
+    void setMeters (StageMeter* meters)
+    {
+        m_meters.store (meters, std::memory_order_release);
+    }
+    
+    StageMeter* getMeters () const
+    {
+        return m_meters.load (std::memory_order_acquire);
     }
     
 public:
     template <typename Sample>
     inline Sample filter(const Sample in)
     {
+        StageMeter* const meters = getMeters ();
+        if (meters || m_glideRemaining > 0)
+            return filterSlow (in, meters);
+        
         double out = in;
         StateType* state = m_states;
-        Biquad const* stage = m_stages;
+        Cascade::Stage* stage = m_stages;
         for (int i = MaxStages; --i >= 0; ++state, ++stage)
             out = state->process1 (out, *stage);
         return static_cast<Sample> (out);
     }
     
+    // Same as calling filter() on every sample, but a block at a time,
+    // see BlockKernel.h. Gliding coefficients change on every sample,
+    // so while a glide is on this simply falls back to filter(). The four
+    // value forms go through the pipeline instead, their block matrices
+    // cost more than they save.
+    template <typename Sample>
+    void filterBlock (int numSamples, Sample* dest)
+    {
+        filterBlock (numSamples, dest, dest);
+    }
+    
+    // Same, but reads src and writes dest, which may also be the same.
+    // Keeps the dry signal around without copying it first.
+    template <typename Sample>
+    void filterBlock (int numSamples, const Sample* src, Sample* dest)
+    {
+        StageMeter* const meters = getMeters ();
+        if (meters)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = filterMetered (src[i], meters);
+            
+            publishMeters (meters);
+        }
+        else if (isGliding ())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = filter (src[i]);
+        }
+        else if (StateType::numValues != 2)
+        {
+            processPipelined<MaxStages> (numSamples, src, dest, m_stages, m_states);
+        }
+        else
+        {
+            m_block.process (numSamples, src, dest, m_stages, m_states, MaxStages);
+        }
+    }
+    
+    // Bit for bit the same as calling filter() on every sample, with
+    // the stages overlapped across samples, see Pipeline.h.
+    template <typename Sample>
+    void filterPipelined (int numSamples, Sample* dest)
+    {
+        if (isGliding ())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = filter (dest[i]);
+        }
+        else
+        {
+            processPipelined<MaxStages> (numSamples, dest, m_stages, m_states);
+        }
+    }
+    
+    // Bit for bit the same as calling filter() on every sample, with
+    // the stages unrolled at compile time, see Unrolled.h.
+    template <typename Sample>
+    void filterUnrolled (int numSamples, Sample* dest)
+    {
+        if (isGliding ())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = filter (dest[i]);
+        }
+        else
+        {
+            processUnrolled<MaxStages> (numSamples, dest, m_stages, m_states);
+        }
+    }
+    
+    // Same as filter() on every sample, up to rounding, with the b0 of all
+    // stages folded into one gain, see StructuredKernel.h. Returns false
+    // and leaves dest alone if the stages aren't all symmetric or one pole,
+    // or the states aren't Direct Form II.
+    template <typename Sample>
+    bool filterStructured (int numSamples, Sample* dest)
+    {
+        if (isGliding ())
+            return false;
+        
+        return processStructured (numSamples, dest, m_states);
+    }
+    
+    // Tile of the block kernel, in samples. Every stage runs across one
+    // tile before the next stage starts, see BlockKernel.h.
+    void setTileSize (int samples)
+    {
+        m_block.setTileSize (samples);
+    }
+    
+    int getTileSize () const
+    {
+        return m_block.getTileSize ();
+    }
+    
+    bool isGliding () const
+    {
+        return m_glideRemaining > 0;
+    }
+    
     Cascade::Storage getCascadeStorage()
     {
         return Cascade::Storage (MaxStages, m_stages);
     }
     
 private:
+    // Metering and glides, kept out of the way of the plain loop in filter()
+    template <typename Sample>
+    Sample filterSlow (const Sample in, StageMeter* meters)
+    {
+        if (meters)
+        {
+            const Sample out = filterMetered (in, meters);
+            publishMeters (meters);
+            return out;
+        }
+        return filterGliding (in);
+    }
+    
+    template <typename Sample>
+    Sample filterGliding (const Sample in)
+    {
+        --m_glideRemaining;
+        
+        double out = in;
+        StateType* state = m_states;
+        Cascade::Stage* stage = m_stages;
+        BiquadRamp* ramp = m_ramps;
+        for (int i = MaxStages; --i >= 0; ++state, ++stage, ++ramp)
+        {
+            if (ramp->isActive ())
+                ramp->step (*stage);
+            out = state->process1 (out, *stage);
+        }
+        return static_cast<Sample> (out);
+    }
+    
+    template <typename Sample>
+    Sample filterMetered (const Sample in, StageMeter* meters)
+    {
+        double values[StateType::numValues];
+        
+        const bool gliding = (m_glideRemaining > 0);
+        if (gliding)
+            --m_glideRemaining;
+        
+        double out = in;
+        for (int i = 0; i < MaxStages; ++i)
+        {
+            if (gliding && m_ramps[i].isActive ())
+                m_ramps[i].step (m_stages[i]);
+            out = m_states[i].process1 (out, m_stages[i]);
+            
+            m_states[i].getValues (values);
+            meters[i].add (values, StateType::numValues, out);
+        }
+        return static_cast<Sample> (out);
+    }
+    
+    void publishMeters (StageMeter* meters)
+    {
+        for (int i = 0; i < MaxStages; ++i)
+            meters[i].publish ();
+    }
+    
+    template <typename Sample>
+    bool processStructured (int numSamples, Sample* dest, DirectFormII* states)
+    {
+        if (! m_structured.prepare (m_stages))
+            return false;
+        
+        m_structured.process (numSamples, dest, states);
+        return true;
+    }
+    
+    template <typename Sample, class OtherState>
+    bool processStructured (int, Sample*, OtherState*)
+    {
+        return false;
+    }
+    
     Cascade::Stage m_stages[MaxStages];
     StateType m_states[MaxStages];
+    BiquadRamp m_ramps[MaxStages];
+    BlockKernel<StateType> m_block;
+    StructuredKernel<MaxStages> m_structured;
+    std::atomic<StageMeter*> m_meters;
+    int m_glideRemaining; // samples until the ramps are done
 };
 
 #endif
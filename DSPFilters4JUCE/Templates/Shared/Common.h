@@ -58,13 +58,59 @@ THE SOFTWARE.
 
 #include <cassert>
 #include <cfloat>
+#include <cstddef>   // for the wrappers' ChannelSpan.h
 #include <cmath>
 #include <complex>
+#include <cstdio>    // for StageMeter.h
 #include <cstring>
+#include <stdint.h>  // for FixedPoint.h
 #include <string>
 #include <limits>
+#include <memory>    // for the wrappers' FilterArray.h
 #include <vector>
 #include <stdexcept> // for RootFinder.h and State.h
+#include <algorithm>
+#include <thread>    // for the zero phase channel threads
+#include <mutex>     // for the wrappers' ChannelWorkers.h
+#include <condition_variable>
+#include <atomic>    // for CpuFeatures.h
+
+// SSE2 is there on every x64 build, the block kernels use it where they can
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DSPFILTERS_SSE2 1
+#include <emmintrin.h>
+#else
+#define DSPFILTERS_SSE2 0
+#endif
+
+// The kernels are also built for AVX2, and pick one at run
+// time, see CpuFeatures.h. Define DSPFILTERS_NO_DISPATCH to stay with SSE2.
+#if DSPFILTERS_SSE2 && (defined (__GNUC__) || defined (__clang__) || defined (_MSC_VER)) && ! defined (DSPFILTERS_NO_DISPATCH)
+#define DSPFILTERS_DISPATCH 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define DSPFILTERS_DISPATCH 0
+#endif
+
+// GCC and Clang only compile intrinsics into functions built for them
+#if DSPFILTERS_DISPATCH && (defined (__GNUC__) || defined (__clang__))
+#define DSPFILTERS_TARGET_AVX2 __attribute__ ((target ("avx2,fma")))
+#else
+#define DSPFILTERS_TARGET_AVX2
+#endif
+
+// NEON is there on every 64 bit ARM, nothing to detect
+#if (defined (__ARM_NEON) && defined (__aarch64__)) || defined (_M_ARM64)
+#define DSPFILTERS_NEON 1
+#include <arm_neon.h>
+#else
+#define DSPFILTERS_NEON 0
+#endif
 
 #ifdef _MSC_VER
 namespace tr1 = std::tr1;
@@ -0,0 +1,194 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_CPUFEATURES_H
+#define DSPFILTERS_CPUFEATURES_H
+
+/*
+ * Runtime CPU feature dispatch.
+ *
+ * Plugins ship one binary to all kinds of machines, so they can't be
+ * built for AVX2 or AVX-512. Instead, the kernels that gain from wider
+ * registers are compiled for those too, with per function target
+ * attributes, and pick a path at run time. The CPU and OS are asked once
+ * what they support, the kernels look at getSimdLevel() whenever they
+ * prepare, not per sample.
+ *
+ * AVX-512 is detected, but none of the kernels measured any faster on it
+ * than on AVX2, so for now it runs the AVX2 paths.
+ *
+ * setSimdLevel() forces a level, to test or benchmark a specific path.
+ * It can't go beyond what the machine runs. The AVX2 and NEON paths use
+ * fused multiply-adds, which round once instead of twice, so their
+ * results can differ from the SSE2 ones in the last bits.
+ *
+ */
+
+enum SimdLevel
+{
+    simdAuto = -1,      // best the machine supports
+    simdScalar,
+    simdSSE2,
+    simdNEON,
+    simdAVX2,           // with FMA
+    simdAVX512          // AVX-512F
+};
+
+#if DSPFILTERS_DISPATCH
+inline void readCpuid (int leaf, int subleaf, unsigned int* regs)
+{
+#ifdef _MSC_VER
+    int r[4];
+    __cpuidex (r, leaf, subleaf);
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<unsigned int> (r[i]);
+#else
+    __cpuid_count (leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// The register states the OS saves on a context switch
+inline unsigned long long getEnabledRegisterStates ()
+{
+#ifdef _MSC_VER
+    return _xgetbv (0);
+#else
+    unsigned int lo, hi;
+    __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+    return (static_cast<unsigned long long> (hi) << 32) | lo;
+#endif
+}
+#endif
+
+inline int detectSimdLevel ()
+{
+#if DSPFILTERS_DISPATCH
+    unsigned int r[4];
+    
+    readCpuid (0, 0, r);
+    const unsigned int maxLeaf = r[0];
+    
+    readCpuid (1, 0, r);
+    const bool fma = (r[2] >> 12) & 1;
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx = (r[2] >> 28) & 1;
+    
+    if (maxLeaf < 7 || ! fma || ! osxsave || ! avx)
+        return simdSSE2;
+    
+    // XMM and YMM, then opmask and both ZMM halves
+    const unsigned long long states = getEnabledRegisterStates ();
+    if ((states & 0x06) != 0x06)
+        return simdSSE2;
+    
+    readCpuid (7, 0, r);
+    const bool avx2 = (r[1] >> 5) & 1;
+    const bool avx512f = (r[1] >> 16) & 1;
+    
+    if (! avx2)
+        return simdSSE2;
+    
+    if (avx512f && (states & 0xe0) == 0xe0)
+        return simdAVX512;
+    
+    return simdAVX2;
+#elif DSPFILTERS_SSE2
+    return simdSSE2;
+#elif DSPFILTERS_NEON
+    return simdNEON;
+#else
+    return simdScalar;
+#endif
+}
+
+inline int getDetectedSimdLevel ()
+{
+    static const int level = detectSimdLevel ();
+    return level;
+}
+
+inline bool isSimdLevelSupported (int level)
+{
+    switch (level)
+    {
+        case simdAuto:
+        case simdScalar:
+            return true;
+            
+        case simdSSE2:
+            return DSPFILTERS_SSE2 != 0;
+            
+        case simdNEON:
+            return DSPFILTERS_NEON != 0;
+            
+        case simdAVX2:
+        case simdAVX512:
+            return DSPFILTERS_DISPATCH != 0 && getDetectedSimdLevel () >= level;
+    }
+    
+    return false;
+}
+
+inline std::atomic<int>& getSimdOverride ()
+{
+    static std::atomic<int> level (simdAuto);
+    return level;
+}
+
+inline int getSimdLevel ()
+{
+    const int level = getSimdOverride ().load (std::memory_order_relaxed);
+    return (level == simdAuto) ? getDetectedSimdLevel () : level;
+}
+
+// Returns false and changes nothing if the machine can't run the level.
+// Kernels pick it up the next time they prepare.
+inline bool setSimdLevel (int level)
+{
+    if (! isSimdLevelSupported (level))
+        return false;
+    
+    getSimdOverride ().store (level, std::memory_order_relaxed);
+    return true;
+}
+
+#endif
@@ -0,0 +1,204 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_PCM_H
+#define DSPFILTERS_PCM_H
+
+/*
+ * Interleaved integer PCM.
+ *
+ * Network and capture audio comes in as interleaved integer frames. The
+ * usual way is three passes over memory per block, deinterleave and
+ * convert, filter, interleave and convert back, and with hundreds of
+ * channels those passes are what the time goes into. The formats below
+ * read and write a sample in place, so the filters can gather a channel
+ * straight out of the frames into a small buffer that stays in the L1
+ * cache, and scatter the result back.
+ *
+ * Samples are little endian, like the machines this runs on. Int24 is
+ * three packed bytes. Full scale is +-1 for float and +-2^31 for Q31,
+ * see FixedPoint.h. Writing rounds to the nearest step and saturates.
+ *
+ */
+
+// Rounds to the nearest step within -(limit + 1) and limit. Shifted up to
+// be positive, truncating rounds down, which is cheaper than floor().
+inline int32_t roundPcm (double x, double limit)
+{
+    x = std::min (std::max (x + limit + 1.5, 0.), 2 * limit + 1.);
+    return static_cast<int32_t> (static_cast<int64_t> (x) - static_cast<int64_t> (limit) - 1);
+}
+
+struct PcmInt16
+{
+    enum { bytesPerSample = 2 };
+    
+    static int32_t readQ31 (const unsigned char* p)
+    {
+        int16_t v;
+        std::memcpy (&v, p, sizeof (v));
+        return static_cast<int32_t> (static_cast<uint32_t> (v) << 16);
+    }
+    
+    static void writeQ31 (unsigned char* p, int32_t q)
+    {
+        const int32_t r = (q >= 0x7fff8000) ? 0x7fff : ((q + 0x8000) >> 16);
+        const int16_t v = static_cast<int16_t> (r);
+        std::memcpy (p, &v, sizeof (v));
+    }
+    
+    static double read (const unsigned char* p)
+    {
+        int16_t v;
+        std::memcpy (&v, p, sizeof (v));
+        return v * (1. / 32768);
+    }
+    
+    static void write (unsigned char* p, double x)
+    {
+        const int16_t v = static_cast<int16_t> (roundPcm (x * 32768, 32767));
+        std::memcpy (p, &v, sizeof (v));
+    }
+};
+
+struct PcmInt24
+{
+    enum { bytesPerSample = 3 };
+    
+    static int32_t readQ31 (const unsigned char* p)
+    {
+        return static_cast<int32_t> ((static_cast<uint32_t> (p[0]) << 8) |
+                                     (static_cast<uint32_t> (p[1]) << 16) |
+                                     (static_cast<uint32_t> (p[2]) << 24));
+    }
+    
+    static void writeQ31 (unsigned char* p, int32_t q)
+    {
+        const int32_t r = (q >= 0x7fffff80) ? 0x7fffff : ((q + 0x80) >> 8);
+        store (p, r);
+    }
+    
+    static double read (const unsigned char* p)
+    {
+        return readQ31 (p) * (1. / 2147483648.);
+    }
+    
+    static void write (unsigned char* p, double x)
+    {
+        store (p, roundPcm (x * 8388608, 8388607));
+    }
+    
+    static void store (unsigned char* p, int32_t v)
+    {
+        const uint32_t u = static_cast<uint32_t> (v);
+        p[0] = static_cast<unsigned char> (u);
+        p[1] = static_cast<unsigned char> (u >> 8);
+        p[2] = static_cast<unsigned char> (u >> 16);
+    }
+};
+
+struct PcmInt32
+{
+    enum { bytesPerSample = 4 };
+    
+    static int32_t readQ31 (const unsigned char* p)
+    {
+        int32_t v;
+        std::memcpy (&v, p, sizeof (v));
+        return v;
+    }
+    
+    static void writeQ31 (unsigned char* p, int32_t q)
+    {
+        std::memcpy (p, &q, sizeof (q));
+    }
+    
+    static double read (const unsigned char* p)
+    {
+        return readQ31 (p) * (1. / 2147483648.);
+    }
+    
+    static void write (unsigned char* p, double x)
+    {
+        writeQ31 (p, roundPcm (x * 2147483648., 2147483647.));
+    }
+};
+
+//------------------------------------------------------------------------------
+
+// Runs filters[c].filterBlock() over channel c of the interleaved frames in
+// src and writes them to dest, which may be src. All channels go through
+// a few frames at a time, so every frame is read and written just once
+// and the rest happens in the cache. 32 frames of a few hundred channels
+// still fit the L1 cache, longer tiles measured slower.
+template <class Format, class FilterType>
+void filterInterleaved (FilterType* filters, int numChannels, int numFrames,
+                        const void* src, void* dest)
+{
+    enum { TileFrames = 32 };
+    
+    const int frameBytes = numChannels * Format::bytesPerSample;
+    const unsigned char* in = static_cast<const unsigned char*> (src);
+    unsigned char* out = static_cast<unsigned char*> (dest);
+    
+    double tile[TileFrames];
+    
+    for (int start = 0; start < numFrames; start += TileFrames)
+    {
+        const int length = std::min (static_cast<int> (TileFrames), numFrames - start);
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const unsigned char* p = in + start * frameBytes + channel * Format::bytesPerSample;
+            for (int i = 0; i < length; ++i, p += frameBytes)
+                tile[i] = Format::read (p);
+            
+            filters[channel].filterBlock (length, tile);
+            
+            unsigned char* q = out + start * frameBytes + channel * Format::bytesPerSample;
+            for (int i = 0; i < length; ++i, q += frameBytes)
+                Format::write (q, tile[i]);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,133 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_PIPELINE_H
+#define DSPFILTERS_PIPELINE_H
+
+/*
+ * Software pipelined cascade
+ *
+ * In a cascade, stage k+1 can't start on a sample before stage k is done
+ * with it, so per sample all stages form one long dependency chain. This
+ * skews the stages across the samples instead: in every step, stage k
+ * works on sample n-k, using what stage k-1 put out in the step before.
+ * Within a step the stages don't depend on each other, so the FP units
+ * can work on all of them at once.
+ *
+ *   step:      n       n+1     n+2
+ *   stage 0:   x[n]    x[n+1]  x[n+2]
+ *   stage 1:   x[n-1]  x[n]    x[n+1]
+ *   stage 2:   x[n-2]  x[n-1]  x[n]
+ *
+ * A prologue fills the pipeline at the start of the block and an epilogue
+ * drains it at the end, so there is no latency. Every stage still runs
+ * process1() of its own state type on the same samples in the same order,
+ * so the result is bit for bit that of filtering sample by sample.
+ *
+ */
+
+// Reads src and writes dest, which may be the same: sample i is written
+// only after sample i has been read.
+template <int NumStages, class StateType, class StageType, typename Sample>
+void processPipelined (int numSamples, const Sample* src, Sample* dest,
+                       const StageType* stages, StateType* states)
+{
+    // too short to fill the pipeline
+    if (NumStages < 2 || numSamples < NumStages)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            double out = src[i];
+            for (int k = 0; k < NumStages; ++k)
+                out = states[k].process1 (out, stages[k]);
+            dest[i] = static_cast<Sample> (out);
+        }
+        return;
+    }
+    
+    // out[k] is what stage k put out in the last step. The stages
+    // go from last to first, so out[k-1] is still the one from before.
+    double out[NumStages];
+    
+    // prologue, stage k joins in at step k
+    for (int i = 0; i < NumStages - 1; ++i)
+    {
+        for (int k = i; k > 0; --k)
+            out[k] = states[k].process1 (out[k - 1], stages[k]);
+        out[0] = states[0].process1 (static_cast<double> (src[i]), stages[0]);
+    }
+    
+    // local copies, so the states can live in registers
+    StateType state[NumStages];
+    for (int k = 0; k < NumStages; ++k)
+        state[k] = states[k];
+    
+    for (int i = NumStages - 1; i < numSamples; ++i)
+    {
+        for (int k = NumStages - 1; k > 0; --k)
+            out[k] = state[k].process1 (out[k - 1], stages[k]);
+        out[0] = state[0].process1 (static_cast<double> (src[i]), stages[0]);
+        
+        dest[i - NumStages + 1] = static_cast<Sample> (out[NumStages - 1]);
+    }
+    
+    for (int k = 0; k < NumStages; ++k)
+        states[k] = state[k];
+    
+    // epilogue, stage k drops out after the last sample
+    for (int i = numSamples; i < numSamples + NumStages - 1; ++i)
+    {
+        for (int k = NumStages - 1; k > i - numSamples; --k)
+            out[k] = states[k].process1 (out[k - 1], stages[k]);
+        
+        dest[i - NumStages + 1] = static_cast<Sample> (out[NumStages - 1]);
+    }
+}
+
+template <int NumStages, class StateType, class StageType, typename Sample>
+void processPipelined (int numSamples, Sample* dest,
+                       const StageType* stages, StateType* states)
+{
+    processPipelined<NumStages> (numSamples, dest, dest, stages, states);
+}
+
+#endif
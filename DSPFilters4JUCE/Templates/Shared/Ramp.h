@@ -0,0 +1,156 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_RAMP_H
+#define DSPFILTERS_RAMP_H
+
+/*
+ * Coefficient ramps for control rate modulation.
+ *
+ * Redesigning a filter on every sample is far more expensive than running
+ * it, so modulated filters are only redesigned every few samples. A ramp
+ * then moves the biquad coefficients from the previous design to the new
+ * one in equal steps, one step per sample, which avoids zipper noise and
+ * keeps the filter states intact.
+ *
+ * The set of stable (a1,a2) pairs is a triangle, and a straight line
+ * between two points inside a triangle never leaves it. So the ramp can
+ * not make a stable biquad unstable on its way to another stable one.
+ *
+ */
+
+class BiquadRamp
+{
+public:
+    BiquadRamp () : m_remaining (0)
+    {
+    }
+    
+    // Remembers the coefficients the ramp will start from.
+    // Call this before the biquad gets redesigned.
+    void begin (const BiquadBase& from)
+    {
+        m_a1 = from.m_a1;
+        m_a2 = from.m_a2;
+        m_b0 = from.m_b0;
+        m_b1 = from.m_b1;
+        m_b2 = from.m_b2;
+    }
+    
+    // Call this after the biquad was redesigned. The new coefficients
+    // become the target, and the biquad is rewound to the start values.
+    void end (BiquadBase& to, int numSamples)
+    {
+        if (numSamples <= 1)
+        {
+            m_remaining = 0;
+            return;
+        }
+        
+        const double scale = 1. / numSamples;
+        
+        std::swap (m_a1, to.m_a1);
+        std::swap (m_a2, to.m_a2);
+        std::swap (m_b0, to.m_b0);
+        std::swap (m_b1, to.m_b1);
+        std::swap (m_b2, to.m_b2);
+        
+        m_da1 = (m_a1 - to.m_a1) * scale;
+        m_da2 = (m_a2 - to.m_a2) * scale;
+        m_db0 = (m_b0 - to.m_b0) * scale;
+        m_db1 = (m_b1 - to.m_b1) * scale;
+        m_db2 = (m_b2 - to.m_b2) * scale;
+        
+        m_remaining = numSamples;
+    }
+    
+    void reset ()
+    {
+        m_remaining = 0;
+    }
+    
+    bool isActive () const
+    {
+        return m_remaining > 0;
+    }
+    
+    // Moves the coefficients one step closer to the target. The last
+    // step lands exactly on the target, so rounding errors can't pile up.
+    inline void step (BiquadBase& b)
+    {
+        if (--m_remaining > 0)
+        {
+            b.m_a1 += m_da1;
+            b.m_a2 += m_da2;
+            b.m_b0 += m_db0;
+            b.m_b1 += m_db1;
+            b.m_b2 += m_db2;
+        }
+        else
+        {
+            b.m_a1 = m_a1;
+            b.m_a2 = m_a2;
+            b.m_b0 = m_b0;
+            b.m_b1 = m_b1;
+            b.m_b2 = m_b2;
+        }
+    }
+    
+private:
+    int m_remaining;
+    
+    // target coefficients
+    double m_a1;
+    double m_a2;
+    double m_b0;
+    double m_b1;
+    double m_b2;
+    
+    // increments per sample
+    double m_da1;
+    double m_da2;
+    double m_db0;
+    double m_db1;
+    double m_db2;
+};
+
+#endif
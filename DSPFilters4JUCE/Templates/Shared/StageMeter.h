@@ -0,0 +1,229 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_STAGEMETER_H
+#define DSPFILTERS_STAGEMETER_H
+
+/*
+ * Per stage headroom instrumentation.
+ *
+ * Whether a filter can run in float or fixed point depends on how large
+ * its states and stage outputs get on real material, which only shows
+ * when running it. A StageMeter collects the peak and RMS of one stage's
+ * state values and output, and counts the samples where any of them went
+ * NaN or infinite. Those are left out of the peaks and sums, a single one
+ * would spoil them for good.
+ *
+ * The audio thread adds to its own totals and publishes them once per
+ * block. Any other thread can read() a consistent copy at any time, or
+ * ask for a reset(), without locks: publishing bumps a sequence count
+ * before and after, and a reader simply tries again if it changed while
+ * reading. Nothing blocks the audio thread.
+ *
+ */
+
+class StageMeter
+{
+public:
+    struct Reading
+    {
+        Reading ()
+        : statePeak (0)
+        , stateSquares (0)
+        , outputPeak (0)
+        , outputSquares (0)
+        , samples (0)
+        , nonFinite (0)
+        {
+        }
+        
+        double getStateRms (int numValues) const
+        {
+            return (samples > 0) ? std::sqrt (stateSquares / (double (samples) * numValues)) : 0;
+        }
+        
+        double getOutputRms () const
+        {
+            return (samples > 0) ? std::sqrt (outputSquares / double (samples)) : 0;
+        }
+        
+        double statePeak;
+        double stateSquares;                // summed over all values
+        double outputPeak;
+        double outputSquares;
+        unsigned long long samples;         // finite ones, those in the sums
+        unsigned long long nonFinite;       // samples with a NaN or Inf anywhere
+    };
+    
+    StageMeter ()
+    : m_sequence (0)
+    , m_resetRequested (false)
+    , m_statePeak (0)
+    , m_stateSquares (0)
+    , m_outputPeak (0)
+    , m_outputSquares (0)
+    , m_samples (0)
+    , m_nonFinite (0)
+    {
+    }
+    
+    // Any thread. The totals start over with the next published block.
+    void reset ()
+    {
+        m_resetRequested.store (true, std::memory_order_release);
+    }
+    
+    // Any thread
+    Reading read () const
+    {
+        Reading r;
+        for (;;)
+        {
+            const unsigned int before = m_sequence.load (std::memory_order_acquire);
+            if (before & 1)
+                continue;
+            
+            r.statePeak = m_statePeak.load (std::memory_order_relaxed);
+            r.stateSquares = m_stateSquares.load (std::memory_order_relaxed);
+            r.outputPeak = m_outputPeak.load (std::memory_order_relaxed);
+            r.outputSquares = m_outputSquares.load (std::memory_order_relaxed);
+            r.samples = m_samples.load (std::memory_order_relaxed);
+            r.nonFinite = m_nonFinite.load (std::memory_order_relaxed);
+            
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (m_sequence.load (std::memory_order_relaxed) == before)
+                return r;
+        }
+    }
+    
+    // Audio thread, once per sample
+    void add (const double* values, int numValues, double output)
+    {
+        const double o = std::abs (output);
+        bool finite = o <= DBL_MAX;
+        
+        double peak = 0;
+        double squares = 0;
+        for (int i = 0; i < numValues; ++i)
+        {
+            const double v = std::abs (values[i]);
+            finite = finite && v <= DBL_MAX;
+            peak = std::max (peak, v);
+            squares += v * v;
+        }
+        
+        if (! finite)
+        {
+            ++m_totals.nonFinite;
+            return;
+        }
+        
+        m_totals.statePeak = std::max (m_totals.statePeak, peak);
+        m_totals.stateSquares += squares;
+        m_totals.outputPeak = std::max (m_totals.outputPeak, o);
+        m_totals.outputSquares += o * o;
+        ++m_totals.samples;
+    }
+    
+    // Audio thread, once per block
+    void publish ()
+    {
+        if (m_resetRequested.exchange (false, std::memory_order_acquire))
+            m_totals = Reading ();
+        
+        const unsigned int sequence = m_sequence.load (std::memory_order_relaxed);
+        m_sequence.store (sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        
+        m_statePeak.store (m_totals.statePeak, std::memory_order_relaxed);
+        m_stateSquares.store (m_totals.stateSquares, std::memory_order_relaxed);
+        m_outputPeak.store (m_totals.outputPeak, std::memory_order_relaxed);
+        m_outputSquares.store (m_totals.outputSquares, std::memory_order_relaxed);
+        m_samples.store (m_totals.samples, std::memory_order_relaxed);
+        m_nonFinite.store (m_totals.nonFinite, std::memory_order_relaxed);
+        
+        m_sequence.store (sequence + 2, std::memory_order_release);
+    }
+    
+private:
+    // written by the audio thread only
+    Reading m_totals;
+    
+    // published copy
+    std::atomic<unsigned int> m_sequence;
+    std::atomic<bool> m_resetRequested;
+    std::atomic<double> m_statePeak;
+    std::atomic<double> m_stateSquares;
+    std::atomic<double> m_outputPeak;
+    std::atomic<double> m_outputSquares;
+    std::atomic<unsigned long long> m_samples;
+    std::atomic<unsigned long long> m_nonFinite;
+};
+
+//------------------------------------------------------------------------------
+
+// One line per stage, levels in dB relative to full scale, and the
+// headroom left above the larger of the two peaks.
+inline std::string getStageMeterReport (const StageMeter* meters, int numStages, int numValues)
+{
+    std::string report ("stage  state peak  state rms  output peak  output rms  headroom  non-finite\n");
+    
+    for (int i = 0; i < numStages; ++i)
+    {
+        const StageMeter::Reading r = meters[i].read ();
+        const double peak = std::max (r.statePeak, r.outputPeak);
+        
+        char line[128];
+        std::snprintf (line, sizeof (line), "%5d  %10.1f  %9.1f  %11.1f  %10.1f  %8.1f  %10llu\n", i,
+                       20 * std::log10 (r.statePeak + 1e-30),
+                       20 * std::log10 (r.getStateRms (numValues) + 1e-30),
+                       20 * std::log10 (r.outputPeak + 1e-30),
+                       20 * std::log10 (r.getOutputRms () + 1e-30),
+                       -20 * std::log10 (peak + 1e-30),
+                       r.nonFinite);
+        report += line;
+    }
+    
+    return report;
+}
+
+#endif
@@ -44,6 +44,15 @@ THE SOFTWARE.
  *
  */
 
+// DC gain of a second order section, needed to start the states
+// in their steady state (initial-state matching, see FiltFilt.h).
+inline double steadyStateGain (const BiquadBase& s)
+{
+    const double den = 1 + s.m_a1 + s.m_a2;
+    assert (den != 0);
+    return (s.m_b0 + s.m_b1 + s.m_b2) / den;
+}
+
 //------------------------------------------------------------------------------
 
 /*
@@ -70,6 +79,39 @@ public:
         m_y2 = 0;
     }
     
+    // Sets the state as if in had been applied forever and
+    // returns the output that goes with it.
+    double setSteadyState (const double in, const BiquadBase& s)
+    {
+        const double out = in * steadyStateGain (s);
+        m_x1 = in;
+        m_x2 = in;
+        m_y1 = out;
+        m_y2 = out;
+        
+        return out;
+    }
+    
+    // Plain access to the state, for engines that treat the whole
+    // cascade as one big state vector (see TimeParallel.h).
+    enum { numValues = 4 };
+    
+    void getValues (double* values) const
+    {
+        values[0] = m_x1;
+        values[1] = m_x2;
+        values[2] = m_y1;
+        values[3] = m_y2;
+    }
+    
+    void setValues (const double* values)
+    {
+        m_x1 = values[0];
+        m_x2 = values[1];
+        m_y1 = values[2];
+        m_y2 = values[3];
+    }
+    
     template <typename Sample>
     inline Sample process1 (const Sample in,
                             const BiquadBase& s)
@@ -116,6 +158,29 @@ public:
         m_v2 = 0;
     }
     
+    double setSteadyState (const double in, const BiquadBase& s)
+    {
+        const double w = in / (1 + s.m_a1 + s.m_a2);
+        m_v1 = w;
+        m_v2 = w;
+        
+        return (s.m_b0 + s.m_b1 + s.m_b2) * w;
+    }
+    
+    enum { numValues = 2 };
+    
+    void getValues (double* values) const
+    {
+        values[0] = m_v1;
+        values[1] = m_v2;
+    }
+    
+    void setValues (const double* values)
+    {
+        m_v1 = values[0];
+        m_v2 = values[1];
+    }
+    
     template <typename Sample>
     Sample process1 (const Sample in,
                      const BiquadBase& s)
@@ -136,6 +201,114 @@ private:
 
 //------------------------------------------------------------------------------
 
+/*
+ * Direct Form I with float states and error feedback
+ *
+ * The sum is formed in double, like the wide accumulator of a fixed point
+ * DSP, and rounded to float as it goes into the states. With poles near
+ * z = 1 that rounding error goes round the recursion and is amplified by
+ * 1/A(z), by a lot at low frequencies. Error feedback adds the errors of
+ * the last samples back in, so the noise is shaped by
+ *
+ *   Order 0:  1 / A(z)                 plain float states
+ *   Order 1:  (1 - 1/z) / A(z)
+ *   Order 2:  (1 - 1/z)^2 / A(z)
+ *
+ * The zeros at DC cancel most of what the poles there add. The noise goes
+ * up at high frequencies instead, where these filters don't amplify it.
+ *
+ * Only the four signal values count as state for get/setValues(), so the
+ * errors restart from zero when a block engine hands the state back.
+ *
+ */
+template <int Order = 2>
+class ErrorFeedbackDirectFormI
+{
+public:
+    ErrorFeedbackDirectFormI ()
+    {
+        reset ();
+    }
+    
+    void reset ()
+    {
+        m_x1 = 0;
+        m_x2 = 0;
+        m_y1 = 0;
+        m_y2 = 0;
+        m_e1 = 0;
+        m_e2 = 0;
+    }
+    
+    double setSteadyState (const double in, const BiquadBase& s)
+    {
+        const double out = in * steadyStateGain (s);
+        m_x1 = static_cast<float> (in);
+        m_x2 = m_x1;
+        m_y1 = static_cast<float> (out);
+        m_y2 = m_y1;
+        m_e1 = 0;
+        m_e2 = 0;
+        
+        return m_y1;
+    }
+    
+    enum { numValues = 4 };
+    
+    void getValues (double* values) const
+    {
+        values[0] = m_x1;
+        values[1] = m_x2;
+        values[2] = m_y1;
+        values[3] = m_y2;
+    }
+    
+    void setValues (const double* values)
+    {
+        m_x1 = static_cast<float> (values[0]);
+        m_x2 = static_cast<float> (values[1]);
+        m_y1 = static_cast<float> (values[2]);
+        m_y2 = static_cast<float> (values[3]);
+        m_e1 = 0;
+        m_e2 = 0;
+    }
+    
+    template <typename Sample>
+    inline Sample process1 (const Sample in,
+                            const BiquadBase& s)
+    {
+        const float x = static_cast<float> (in);
+        double acc = s.m_b0*x + s.m_b1*m_x1 + s.m_b2*m_x2
+        - s.m_a1*m_y1 - s.m_a2*m_y2;
+        
+        if (Order == 1)
+            acc -= m_e1;
+        else if (Order == 2)
+            acc -= 2*m_e1 - m_e2;
+        
+        const float out = static_cast<float> (acc);
+        
+        m_x2 = m_x1;
+        m_y2 = m_y1;
+        m_e2 = m_e1;
+        m_x1 = x;
+        m_y1 = out;
+        m_e1 = out - acc;
+        
+        return static_cast<Sample> (out);
+    }
+    
+private:
+    float m_x1;
+    float m_x2;
+    float m_y1;
+    float m_y2;
+    double m_e1; // error of y[n-1]
+    double m_e2; // error of y[n-2]
+};
+
+//------------------------------------------------------------------------------
+
 /*
  * Transposed Direct Form I and II
  * by lubomir i. ivanov (neolit123 [at] gmail)
@@ -145,7 +318,7 @@ private:
  *
  */
 
-// I think this one is broken
+// Was thought to be broken, but matches Direct Form I to within rounding
 class TransposedDirectFormI
 {
 public:
@@ -167,6 +340,25 @@ public:
         m_s4_1 = 0;
     }
     
+    // m_v and the values without _1 are only scratch within process1()
+    enum { numValues = 4 };
+    
+    void getValues (double* values) const
+    {
+        values[0] = m_s1_1;
+        values[1] = m_s2_1;
+        values[2] = m_s3_1;
+        values[3] = m_s4_1;
+    }
+    
+    void setValues (const double* values)
+    {
+        m_s1 = m_s1_1 = values[0];
+        m_s2 = m_s2_1 = values[1];
+        m_s3 = m_s3_1 = values[2];
+        m_s4 = m_s4_1 = values[3];
+    }
+    
     template <typename Sample>
     inline Sample process1 (const Sample in,
                             const BiquadBase& s)
@@ -219,6 +411,32 @@ public:
         m_s2_1 = 0;
     }
     
+    double setSteadyState (const double in, const BiquadBase& s)
+    {
+        const double out = in * steadyStateGain (s);
+        m_s1 = out - s.m_b0*in;
+        m_s2 = s.m_b2*in - s.m_a2*out;
+        m_s1_1 = m_s1;
+        m_s2_1 = m_s2;
+        
+        return out;
+    }
+    
+    // m_s1 and m_s2 are only scratch values within process1()
+    enum { numValues = 2 };
+    
+    void getValues (double* values) const
+    {
+        values[0] = m_s1_1;
+        values[1] = m_s2_1;
+    }
+    
+    void setValues (const double* values)
+    {
+        m_s1 = m_s1_1 = values[0];
+        m_s2 = m_s2_1 = values[1];
+    }
+    
     template <typename Sample>
     inline Sample process1 (const Sample in,
                             const BiquadBase& s)
@@ -241,4 +459,792 @@ private:
     double m_s2_1;
 };
 
+//------------------------------------------------------------------------------
+
+/*
+ * Coupled form (Gold-Rader) and normalized lattice
+ *
+ * Poles close to z = 1 put a1 near -2 and a2 near 1, and the direct forms
+ * then subtract large, nearly equal numbers. Their coefficients also
+ * place poles very coarsely there: in float, a low pass at a few dozen
+ * Hz is a rounding error away from the unit circle. The coupled form
+ * works on the real and imaginary parts of the pole instead, which are
+ * spread evenly around the circle. The normalized lattice is built from
+ * rotations that can't gain energy, so its states stay bounded.
+ *
+ * Both take a Value type to keep the states and coefficients in, so the
+ * per sample arithmetic can be float. The coefficients convert from the
+ * direct form ones when a state meets a new BiquadBase, so they work in
+ * any cascade. They can also be set up from the pole/zero pairs of a
+ * layout, which skips the trip through a1 and a2.
+ *
+ */
+
+// Of the 3x3 matrix with the given columns
+inline double determinant (const double* c0, const double* c1, const double* c2)
+{
+    return c0[0] * (c1[1] * c2[2] - c2[1] * c1[2])
+         - c1[0] * (c0[1] * c2[2] - c2[1] * c0[2])
+         + c2[0] * (c0[1] * c1[2] - c1[1] * c0[2]);
+}
+
+// One of the 2x2 state space forms below, turned into a transfer function
+// of the given direct form coefficients. The response from the input to
+// each state and the output is found by running an impulse through the
+// form, and the output taps are solved for from those.
+inline void solveOutputTaps (const double response[3][3], const double* a,
+                             const double* b, double* taps)
+{
+    // numerators of the state responses, times the common denominator
+    double n[3][3];
+    for (int m = 0; m < 3; ++m)
+        for (int j = 0; j < 3; ++j)
+        {
+            n[m][j] = 0;
+            for (int i = 0; i <= j; ++i)
+                n[m][j] += a[i] * response[m][j - i];
+        }
+    
+    // sum of taps[m] * n[m] = b, by Cramer's rule
+    const double det = determinant (n[0], n[1], n[2]);
+    assert (det != 0);
+    
+    taps[0] = determinant (b, n[1], n[2]) / det;
+    taps[1] = determinant (n[0], b, n[2]) / det;
+    taps[2] = determinant (n[0], n[1], b) / det;
+}
+
+//------------------------------------------------------------------------------
+
+/*
+ * Coupled form coefficients
+ *
+ *  y[n]  = d*x[n] + c1*s1[n] + c2*s2[n]
+ *  s1[n+1] = re*s1[n] + k12*s2[n] + x[n]
+ *  s2[n+1] = k21*s1[n] + re*s2[n]
+ *
+ * For a complex pole pair k21 = -k12 = the imaginary part, real poles
+ * use k12 = k21 = half their distance. A double pole has k12 = 0.
+ *
+ */
+template <typename Value = double>
+struct CoupledFormCoefficients
+{
+    void setup (const BiquadBase& s)
+    {
+        const double re = -s.m_a1 / 2;
+        const double d = re * re - s.m_a2;
+        
+        if (d < 0)
+            setup (s, re, -std::sqrt (-d), std::sqrt (-d));
+        else if (d > 0)
+            setup (s, re, std::sqrt (d), std::sqrt (d));
+        else
+            setup (s, re, 0, 1);
+    }
+    
+    // The poles and zeros as in a layout, the numerator scaled by scale
+    void setup (const PoleZeroPair& pair, double scale = 1)
+    {
+        Biquad s;
+        s.setPoleZeroPair (pair);
+        s.applyScale (scale);
+        
+        const complex_t p1 = pair.poles.first;
+        const complex_t p2 = pair.isSinglePole () ? complex_t (0) : pair.poles.second;
+        
+        if (p1.imag () != 0)
+            setup (s, p1.real (), -std::abs (p1.imag ()), std::abs (p1.imag ()));
+        else if (p1.real () != p2.real ())
+            setup (s, (p1.real () + p2.real ()) / 2,
+                   std::abs (p1.real () - p2.real ()) / 2,
+                   std::abs (p1.real () - p2.real ()) / 2);
+        else
+            setup (s, p1.real (), 0, 1);
+    }
+    
+    Value d;
+    Value c1;
+    Value c2;
+    Value re;
+    Value k12;
+    Value k21;
+    
+private:
+    void setup (const BiquadBase& s, double re_, double k12_, double k21_)
+    {
+        // the denominator as the form realizes it
+        const double a[3] = { 1, -2 * re_, re_ * re_ - k12_ * k21_ };
+        const double b[3] = { s.m_b0, s.m_b1, s.m_b2 };
+        
+        // responses of the input tap and both states to an impulse
+        double response[3][3];
+        double s1 = 0;
+        double s2 = 0;
+        for (int n = 0; n < 3; ++n)
+        {
+            const double x = (n == 0) ? 1 : 0;
+            response[0][n] = x;
+            response[1][n] = s1;
+            response[2][n] = s2;
+            
+            const double next = re_ * s1 + k12_ * s2 + x;
+            s2 = k21_ * s1 + re_ * s2;
+            s1 = next;
+        }
+        
+        double taps[3];
+        solveOutputTaps (response, a, b, taps);
+        
+        d = static_cast<Value> (taps[0]);
+        c1 = static_cast<Value> (taps[1]);
+        c2 = static_cast<Value> (taps[2]);
+        re = static_cast<Value> (re_);
+        k12 = static_cast<Value> (k12_);
+        k21 = static_cast<Value> (k21_);
+    }
+};
+
+/*
+ * State for applying a second order section in coupled form
+ *
+ */
+template <typename Value = double>
+class CoupledForm
+{
+public:
+    typedef CoupledFormCoefficients<Value> Coefficients;
+    
+    CoupledForm ()
+    : m_coefficients ()
+    , m_source ()
+    , m_ready (false)
+    {
+        reset ();
+    }
+    
+    void reset ()
+    {
+        m_s1 = 0;
+        m_s2 = 0;
+    }
+    
+    double setSteadyState (const double in, const BiquadBase& s)
+    {
+        update (s);
+        
+        // (I - A) * state = (in, 0)
+        const Coefficients& c = m_coefficients;
+        const double m11 = 1 - c.re;
+        const double m22 = 1 - c.re;
+        const double det = m11 * m22 - double (c.k12) * c.k21;
+        assert (det != 0);
+        
+        const double s1 = m22 * in / det;
+        const double s2 = c.k21 * in / det;
+        m_s1 = static_cast<Value> (s1);
+        m_s2 = static_cast<Value> (s2);
+        
+        return c.d * in + c.c1 * s1 + c.c2 * s2;
+    }
+    
+    enum { numValues = 2 };
+    
+    void getValues (double* values) const
+    {
+        values[0] = m_s1;
+        values[1] = m_s2;
+    }
+    
+    void setValues (const double* values)
+    {
+        m_s1 = static_cast<Value> (values[0]);
+        m_s2 = static_cast<Value> (values[1]);
+    }
+    
+    template <typename Sample>
+    inline Sample process1 (const Sample in,
+                            const BiquadBase& s)
+    {
+        update (s);
+        return process1 (in, m_coefficients);
+    }
+    
+    template <typename Sample>
+    inline Sample process1 (const Sample in,
+                            const Coefficients& c)
+    {
+        const Value x = static_cast<Value> (in);
+        const Value out = c.d*x + c.c1*m_s1 + c.c2*m_s2;
+        const Value s1 = c.re*m_s1 + c.k12*m_s2 + x;
+        
+        m_s2 = c.k21*m_s1 + c.re*m_s2;
+        m_s1 = s1;
+        
+        return static_cast<Sample> (out);
+    }
+    
+private:
+    void update (const BiquadBase& s)
+    {
+        if (m_ready && s.hasSameCoefficients (m_source))
+            return;
+        
+        m_source = s;
+        m_ready = true;
+        m_coefficients.setup (s);
+    }
+    
+    Value m_s1;
+    Value m_s2;
+    Coefficients m_coefficients;
+    BiquadBase m_source;
+    bool m_ready;
+};
+
+//------------------------------------------------------------------------------
+
+/*
+ * Normalized lattice coefficients (Gray-Markel)
+ *
+ *  f1      = c2*x[n] - k2*g1[n-1]      g2 = k2*x[n] + c2*g1[n-1]
+ *  f0      = c1*f1   - k1*g0[n-1]      g1 = k1*f1   + c1*g0[n-1]
+ *  g0      = f0
+ *  y[n]    = v0*g0 + v1*g1 + v2*g2
+ *
+ * with the reflection coefficients k2 = a2, k1 = a1 / (1 + a2) and
+ * c = sqrt (1 - k^2). The section is stable as long as |k| < 1.
+ *
+ */
+template <typename Value = double>
+struct NormalizedLatticeCoefficients
+{
+    void setup (const BiquadBase& s)
+    {
+        setup (s, s.m_a2);
+    }
+    
+    // The poles and zeros as in a layout, the numerator scaled by scale
+    void setup (const PoleZeroPair& pair, double scale = 1)
+    {
+        Biquad s;
+        s.setPoleZeroPair (pair);
+        s.applyScale (scale);
+        
+        const complex_t p2 = pair.isSinglePole () ? complex_t (0) : pair.poles.second;
+        setup (s, (pair.poles.first * p2).real ());
+    }
+    
+    Value k1;
+    Value c1;
+    Value k2;
+    Value c2;
+    Value v0;
+    Value v1;
+    Value v2;
+    
+private:
+    void setup (const BiquadBase& s, double a2)
+    {
+        const double k2_ = a2;
+        const double k1_ = s.m_a1 / (1 + a2);
+        const double c2_ = std::sqrt ((1 - k2_) * (1 + k2_));
+        const double c1_ = std::sqrt ((1 - k1_) * (1 + k1_));
+        
+        const double a[3] = { 1, k1_ * (1 + k2_), k2_ };
+        const double b[3] = { s.m_b0, s.m_b1, s.m_b2 };
+        
+        // responses of the three ladder taps to an impulse
+        double response[3][3];
+        double g0 = 0;
+        double g1 = 0;
+        for (int n = 0; n < 3; ++n)
+        {
+            const double x = (n == 0) ? 1 : 0;
+            const double f1 = c2_ * x - k2_ * g1;
+            const double g2 = k2_ * x + c2_ * g1;
+            const double f0 = c1_ * f1 - k1_ * g0;
+            g1 = k1_ * f1 + c1_ * g0;
+            g0 = f0;
+            
+            response[0][n] = g0;
+            response[1][n] = g1;
+            response[2][n] = g2;
+        }
+        
+        double taps[3];
+        solveOutputTaps (response, a, b, taps);
+        
+        k1 = static_cast<Value> (k1_);
+        c1 = static_cast<Value> (c1_);
+        k2 = static_cast<Value> (k2_);
+        c2 = static_cast<Value> (c2_);
+        v0 = static_cast<Value> (taps[0]);
+        v1 = static_cast<Value> (taps[1]);
+        v2 = static_cast<Value> (taps[2]);
+    }
+};
+
+/*
+ * State for applying a second order section as a normalized lattice
+ *
+ */
+template <typename Value = double>
+class NormalizedLattice
+{
+public:
+    typedef NormalizedLatticeCoefficients<Value> Coefficients;
+    
+    NormalizedLattice ()
+    : m_coefficients ()
+    , m_source ()
+    , m_ready (false)
+    {
+        reset ();
+    }
+    
+    void reset ()
+    {
+        m_g0 = 0;
+        m_g1 = 0;
+    }
+    
+    // With a constant input, g1 settles at f1 and g0 at c1*f1 / (1 + k1)
+    double setSteadyState (const double in, const BiquadBase& s)
+    {
+        update (s);
+        
+        const Coefficients& c = m_coefficients;
+        const double f1 = c.c2 * in / (1 + double (c.k2));
+        const double g0 = c.c1 * f1 / (1 + double (c.k1));
+        const double g2 = c.k2 * in + c.c2 * f1;
+        m_g0 = static_cast<Value> (g0);
+        m_g1 = static_cast<Value> (f1);
+        
+        return c.v0 * g0 + c.v1 * f1 + c.v2 * g2;
+    }
+    
+    enum { numValues = 2 };
+    
+    void getValues (double* values) const
+    {
+        values[0] = m_g0;
+        values[1] = m_g1;
+    }
+    
+    void setValues (const double* values)
+    {
+        m_g0 = static_cast<Value> (values[0]);
+        m_g1 = static_cast<Value> (values[1]);
+    }
+    
+    template <typename Sample>
+    inline Sample process1 (const Sample in,
+                            const BiquadBase& s)
+    {
+        update (s);
+        return process1 (in, m_coefficients);
+    }
+    
+    template <typename Sample>
+    inline Sample process1 (const Sample in,
+                            const Coefficients& c)
+    {
+        const Value x = static_cast<Value> (in);
+        const Value f1 = c.c2*x - c.k2*m_g1;
+        const Value g2 = c.k2*x + c.c2*m_g1;
+        const Value f0 = c.c1*f1 - c.k1*m_g0;
+        const Value g1 = c.k1*f1 + c.c1*m_g0;
+        
+        m_g0 = f0;
+        m_g1 = g1;
+        
+        return static_cast<Sample> (c.v0*f0 + c.v1*g1 + c.v2*g2);
+    }
+    
+private:
+    void update (const BiquadBase& s)
+    {
+        if (m_ready && s.hasSameCoefficients (m_source))
+            return;
+        
+        m_source = s;
+        m_ready = true;
+        m_coefficients.setup (s);
+    }
+    
+    Value m_g0;
+    Value m_g1;
+    Coefficients m_coefficients;
+    BiquadBase m_source;
+    bool m_ready;
+};
+
+//------------------------------------------------------------------------------
+
+/*
+ * Realization picked per stage
+ *
+ * Every stage of a cascade gets the cheapest form that still reaches
+ * TargetDb of signal to noise, from float transposed direct form II over
+ * double direct form II to the double coupled form. The noise of a form
+ * is estimated from its state space description: a rounding error in a
+ * state is as large as the state, relative, and reaches the output
+ * through the response from that state. Summed over both states and
+ * scaled by the output's own energy, that gives
+ *
+ *   N/S = eps^2 * sum over j of E (in -> state j) * E (state j -> out)
+ *                                 / E (in -> out)
+ *
+ * with E the energy of the response, taken from the controllability and
+ * observability Gramians of the form. Float also has to keep the rounded
+ * poles inside the unit circle. If no form makes the target, the one
+ * with the least noise is used.
+ *
+ * The choice is made again whenever the coefficients change. If a glide
+ * moves a stage into another form, the state is carried over such that
+ * the output without input stays the same.
+ *
+ * get/setValues() are those of the form in use, so the form has to be
+ * picked for the coefficients before they are called. The block engines
+ * do that through prepareState(), like process1() would on its first
+ * sample with the coefficients.
+ *
+ */
+template <int TargetDb = 120>
+class AdaptiveForm
+{
+public:
+    enum Realization
+    {
+        floatTransposedII,
+        directFormII,
+        coupledForm
+    };
+    
+    AdaptiveForm ()
+    : m_source ()
+    , m_ready (false)
+    , m_realization (directFormII)
+    {
+    }
+    
+    int getRealization () const
+    {
+        return m_realization;
+    }
+    
+    // Picks the form for these coefficients, as the next process1() would
+    void prepare (const BiquadBase& s)
+    {
+        update (s);
+    }
+    
+    void reset ()
+    {
+        m_float.reset ();
+        m_direct.reset ();
+        m_coupled.reset ();
+    }
+    
+    double setSteadyState (const double in, const BiquadBase& s)
+    {
+        update (s);
+        
+        switch (m_realization)
+        {
+            case floatTransposedII: return m_float.setSteadyState (in, s);
+            case directFormII:      return m_direct.setSteadyState (in, s);
+            default:                return m_coupled.setSteadyState (in, s);
+        }
+    }
+    
+    enum { numValues = 2 };
+    
+    void getValues (double* values) const
+    {
+        switch (m_realization)
+        {
+            case floatTransposedII: m_float.getValues (values); break;
+            case directFormII:      m_direct.getValues (values); break;
+            default:                m_coupled.getValues (values); break;
+        }
+    }
+    
+    void setValues (const double* values)
+    {
+        switch (m_realization)
+        {
+            case floatTransposedII: m_float.setValues (values); break;
+            case directFormII:      m_direct.setValues (values); break;
+            default:                m_coupled.setValues (values); break;
+        }
+    }
+    
+    template <typename Sample>
+    inline Sample process1 (const Sample in,
+                            const BiquadBase& s)
+    {
+        update (s);
+        
+        switch (m_realization)
+        {
+            case floatTransposedII: return m_float.process1 (in, s);
+            case directFormII:      return m_direct.process1 (in, s);
+            default:                return m_coupled.process1 (in, s);
+        }
+    }
+    
+private:
+    // Transposed direct form II in float, states and arithmetic
+    class FloatTransposedII
+    {
+    public:
+        FloatTransposedII ()
+        {
+            reset ();
+        }
+        
+        void reset ()
+        {
+            m_s1 = 0;
+            m_s2 = 0;
+        }
+        
+        double setSteadyState (const double in, const BiquadBase& s)
+        {
+            const double out = in * steadyStateGain (s);
+            m_s1 = static_cast<float> (out - s.m_b0*in);
+            m_s2 = static_cast<float> (s.m_b2*in - s.m_a2*out);
+            
+            return out;
+        }
+        
+        void getValues (double* values) const
+        {
+            values[0] = m_s1;
+            values[1] = m_s2;
+        }
+        
+        void setValues (const double* values)
+        {
+            m_s1 = static_cast<float> (values[0]);
+            m_s2 = static_cast<float> (values[1]);
+        }
+        
+        template <typename Sample>
+        inline Sample process1 (const Sample in,
+                                const BiquadBase& s)
+        {
+            const float x = static_cast<float> (in);
+            const float out = m_s1 + float (s.m_b0)*x;
+            m_s1 = m_s2 + float (s.m_b1)*x - float (s.m_a1)*out;
+            m_s2 = float (s.m_b2)*x - float (s.m_a2)*out;
+            
+            return static_cast<Sample> (out);
+        }
+        
+    private:
+        float m_s1;
+        float m_s2;
+    };
+    
+    void update (const BiquadBase& s)
+    {
+        if (m_ready && s.hasSameCoefficients (m_source))
+            return;
+        
+        const int realization = choose (s);
+        
+        if (m_ready && realization != m_realization)
+        {
+            double y[2];
+            switch (m_realization)
+            {
+                case floatTransposedII: getZeroInputResponse (m_float, m_source, y); break;
+                case directFormII:      getZeroInputResponse (m_direct, m_source, y); break;
+                default:                getZeroInputResponse (m_coupled, m_source, y); break;
+            }
+            
+            switch (realization)
+            {
+                case floatTransposedII: setZeroInputResponse (m_float, s, y); break;
+                case directFormII:      setZeroInputResponse (m_direct, s, y); break;
+                default:                setZeroInputResponse (m_coupled, s, y); break;
+            }
+        }
+        
+        m_source = s;
+        m_ready = true;
+        m_realization = realization;
+    }
+    
+    static int choose (const BiquadBase& s)
+    {
+        const double floatSnr = isStableInFloat (s) ?
+            estimateSnr (getTransposedII (s), 1. / (1 << 24)) : 0;
+        if (floatSnr >= TargetDb)
+            return floatTransposedII;
+        
+        const double doubleEps = std::numeric_limits<double>::epsilon () / 2;
+        const double directSnr = estimateSnr (getDirectFormII (s), doubleEps);
+        if (directSnr >= TargetDb)
+            return directFormII;
+        
+        const double coupledSnr = estimateSnr (getCoupledForm (s), doubleEps);
+        if (coupledSnr >= TargetDb || coupledSnr > directSnr)
+            return coupledForm;
+        
+        return (directSnr >= floatSnr) ? directFormII : floatTransposedII;
+    }
+    
+    static bool isStableInFloat (const BiquadBase& s)
+    {
+        const double a1 = static_cast<float> (s.m_a1);
+        const double a2 = static_cast<float> (s.m_a2);
+        
+        return std::abs (a2) < 1 && std::abs (a1) < 1 + a2;
+    }
+    
+    // A section as x' = A x + B in, out = C x + D in
+    struct StateSpace
+    {
+        double a[2][2];
+        double b[2];
+        double c[2];
+        double d;
+    };
+    
+    // Solves W = A W A' + Q for the symmetric W, packed as w11, w12, w22
+    static void solveGramian (const double a[2][2], const double* q, double* w)
+    {
+        // columns of (I - the map from W to A W A') in the packed unknowns
+        const double c0[3] = { 1 - a[0][0] * a[0][0], -a[0][0] * a[1][0], -a[1][0] * a[1][0] };
+        const double c1[3] = { -2 * a[0][0] * a[0][1], 1 - a[0][0] * a[1][1] - a[0][1] * a[1][0], -2 * a[1][0] * a[1][1] };
+        const double c2[3] = { -a[0][1] * a[0][1], -a[0][1] * a[1][1], 1 - a[1][1] * a[1][1] };
+        
+        const double det = determinant (c0, c1, c2);
+        w[0] = determinant (q, c1, c2) / det;
+        w[1] = determinant (c0, q, c2) / det;
+        w[2] = determinant (c0, c1, q) / det;
+    }
+    
+    // The energies of the responses come straight from the Gramians, which
+    // is cheap enough to do on every sample of a glide.
+    static double estimateSnr (const StateSpace& f, double eps)
+    {
+        const double transposed[2][2] = { { f.a[0][0], f.a[1][0] }, { f.a[0][1], f.a[1][1] } };
+        const double bb[3] = { f.b[0] * f.b[0], f.b[0] * f.b[1], f.b[1] * f.b[1] };
+        const double cc[3] = { f.c[0] * f.c[0], f.c[0] * f.c[1], f.c[1] * f.c[1] };
+        
+        double controllability[3];
+        double observability[3];
+        solveGramian (f.a, bb, controllability);
+        solveGramian (transposed, cc, observability);
+        
+        const double output = f.d * f.d + cc[0] * controllability[0]
+                            + 2 * cc[1] * controllability[1] + cc[2] * controllability[2];
+        const double noise = controllability[0] * observability[0]
+                           + controllability[2] * observability[2];
+        
+        if (! (output > 0) || ! (noise >= 0))
+            return 0;
+        
+        const double ratio = eps * eps * noise / output;
+        return (ratio > 0) ? -10 * std::log10 (ratio) : 1000;
+    }
+    
+    static StateSpace getDirectFormII (const BiquadBase& s)
+    {
+        const StateSpace f = { { { -s.m_a1, -s.m_a2 }, { 1, 0 } }, { 1, 0 },
+                               { s.m_b1 - s.m_b0 * s.m_a1, s.m_b2 - s.m_b0 * s.m_a2 }, s.m_b0 };
+        return f;
+    }
+    
+    static StateSpace getTransposedII (const BiquadBase& s)
+    {
+        const StateSpace f = { { { -s.m_a1, 1 }, { -s.m_a2, 0 } },
+                               { s.m_b1 - s.m_a1 * s.m_b0, s.m_b2 - s.m_a2 * s.m_b0 }, { 1, 0 }, s.m_b0 };
+        return f;
+    }
+    
+    static StateSpace getCoupledForm (const BiquadBase& s)
+    {
+        CoupledFormCoefficients<> c;
+        c.setup (s);
+        const StateSpace f = { { { c.re, c.k12 }, { c.k21, c.re } }, { 1, 0 }, { c.c1, c.c2 }, c.d };
+        return f;
+    }
+    
+    // Two samples of output without input pin the state of a second order
+    // section down, so they are what is carried from one form to another.
+    template <class Form>
+    static void getZeroInputResponse (const Form& from, const BiquadBase& s, double* y)
+    {
+        Form form = from;
+        y[0] = form.process1 (0., s);
+        y[1] = form.process1 (0., s);
+    }
+    
+    template <class Form>
+    static void setZeroInputResponse (Form& to, const BiquadBase& s, const double* y)
+    {
+        // response of the form to each of its unit states
+        double o[2][2];
+        double values[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            values[0] = (j == 0) ? 1 : 0;
+            values[1] = (j == 1) ? 1 : 0;
+            
+            Form form;
+            form.setValues (values);
+            o[0][j] = form.process1 (0., s);
+            o[1][j] = form.process1 (0., s);
+        }
+        
+        const double det = o[0][0] * o[1][1] - o[0][1] * o[1][0];
+        if (det != 0)
+        {
+            values[0] = (y[0] * o[1][1] - o[0][1] * y[1]) / det;
+            values[1] = (o[0][0] * y[1] - o[1][0] * y[0]) / det;
+        }
+        else
+        {
+            // first order, one state is enough
+            values[0] = (o[0][0] != 0) ? y[0] / o[0][0] : 0;
+            values[1] = 0;
+        }
+        
+        to.reset ();
+        to.setValues (values);
+    }
+    
+    FloatTransposedII m_float;
+    DirectFormII m_direct;
+    CoupledForm<> m_coupled;
+    BiquadBase m_source;
+    bool m_ready;
+    int m_realization;
+};
+
+//------------------------------------------------------------------------------
+
+/*
+ * Called on a state before its values are read or written by something
+ * other than process1(), with the coefficients it is about to run with.
+ * Nothing to do for states that always keep the same layout.
+ *
+ */
+template <class StateType>
+inline void prepareState (StateType&, const BiquadBase&)
+{
+}
+
+template <int TargetDb>
+inline void prepareState (AdaptiveForm<TargetDb>& state, const BiquadBase& s)
+{
+    state.prepare (s);
+}
+
 #endif
@@ -0,0 +1,194 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_STRUCTUREDKERNEL_H
+#define DSPFILTERS_STRUCTUREDKERNEL_H
+
+/*
+ * Structure aware kernel for Direct Form II cascades.
+ *
+ * The zeros of low pass, high pass and band stop stages sit on the unit
+ * circle, so their numerators are symmetric, b2 = b0. Odd orders add a
+ * one pole stage with b2 = 0. Pulling b0 out of every stage leaves
+ *
+ *   out = (w + v2) + (b1/b0) * v1      symmetric
+ *   out =  w       + (b1/b0) * v1      one pole
+ *
+ * with one multiply for the numerator instead of three. The b0 of all
+ * stages multiply into a single gain, applied once at the very end.
+ *
+ * Without its b0, every stage sees its input scaled by the b0 of the
+ * stages before it, and so does its state. The states are scaled back
+ * and forth at the edges of every block, so they can be picked up by
+ * regular processing at any time. The structure is found when the
+ * coefficients change, stages of any other shape can't use this.
+ *
+ */
+
+template <int NumStages>
+class StructuredKernel
+{
+public:
+    StructuredKernel ()
+    : m_prepared (false)
+    , m_valid (false)
+    , m_onePole (false)
+    , m_gain (1)
+    {
+    }
+    
+    // True if all stages have a shape this kernel can use
+    template <class StageType>
+    bool prepare (const StageType* stages)
+    {
+        bool changed = ! m_prepared;
+        for (int k = 0; k < NumStages && ! changed; ++k)
+            changed = ! stages[k].hasSameCoefficients (m_stages[k]);
+        
+        if (! changed)
+            return m_valid;
+        
+        m_prepared = true;
+        m_valid = true;
+        m_onePole = false;
+        m_gain = 1;
+        
+        for (int k = 0; k < NumStages; ++k)
+        {
+            const BiquadBase& s = stages[k];
+            const int structure = s.getStructure ();
+            
+            m_stages[k] = s;
+            m_valid = m_valid && structure != BiquadBase::generalStructure && s.m_b0 != 0;
+            m_onePole = m_onePole || structure == BiquadBase::onePoleStructure;
+            
+            // the scale of the stage's input, then that of its output
+            m_scale[k] = m_gain;
+            m_gain *= s.m_b0;
+            
+            m_a1[k] = s.m_a1;
+            m_a2[k] = s.m_a2;
+            m_c1[k] = (s.m_b0 != 0) ? s.m_b1 / s.m_b0 : 0;
+            m_c2[k] = (structure == BiquadBase::onePoleStructure) ? 0 : 1;
+        }
+        
+        return m_valid;
+    }
+    
+    template <typename Sample>
+    void process (int numSamples, Sample* dest, DirectFormII* states)
+    {
+        assert (m_valid);
+        
+        double v1[NumStages];
+        double v2[NumStages];
+        
+        for (int k = 0; k < NumStages; ++k)
+        {
+            double values[2];
+            states[k].getValues (values);
+            v1[k] = values[0] / m_scale[k];
+            v2[k] = values[1] / m_scale[k];
+        }
+        
+        if (m_onePole)
+            run<true> (numSamples, dest, v1, v2);
+        else
+            run<false> (numSamples, dest, v1, v2);
+        
+        for (int k = 0; k < NumStages; ++k)
+        {
+            const double values[2] = { v1[k] * m_scale[k], v2[k] * m_scale[k] };
+            states[k].setValues (values);
+        }
+    }
+    
+private:
+    template <bool OnePole, typename Sample>
+    void run (int numSamples, Sample* dest, double* v1, double* v2) const
+    {
+        double a1[NumStages];
+        double a2[NumStages];
+        double c1[NumStages];
+        double c2[NumStages];
+        for (int k = 0; k < NumStages; ++k)
+        {
+            a1[k] = m_a1[k];
+            a2[k] = m_a2[k];
+            c1[k] = m_c1[k];
+            c2[k] = m_c2[k];
+        }
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            double out = dest[i];
+            
+            for (int k = 0; k < NumStages; ++k)
+            {
+                const double w = out - a1[k]*v1[k] - a2[k]*v2[k];
+                
+                if (OnePole)
+                    out = (w + c2[k]*v2[k]) + c1[k]*v1[k];
+                else
+                    out = (w + v2[k]) + c1[k]*v1[k];
+                
+                v2[k] = v1[k];
+                v1[k] = w;
+            }
+            
+            dest[i] = static_cast<Sample> (m_gain * out);
+        }
+    }
+    
+    BiquadBase m_stages[NumStages];
+    bool m_prepared;
+    bool m_valid;
+    bool m_onePole;
+    double m_gain;
+    double m_scale[NumStages];
+    double m_a1[NumStages];
+    double m_a2[NumStages];
+    double m_c1[NumStages];
+    double m_c2[NumStages];
+};
+
+#endif
@@ -0,0 +1,109 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_UNROLLED_H
+#define DSPFILTERS_UNROLLED_H
+
+/*
+ * Compile time unrolled cascade
+ *
+ * The stage count of a pole filter is a template argument, so the loop
+ * over the stages can be generated instead of run. Stage<0> calls the
+ * first stage and hands its output to Stage<1>, and so on, so nothing is
+ * left but straight code the compiler sees in one piece.
+ *
+ * processUnrolled() copies the coefficients and states into locals once
+ * per block, then every sample runs through the unrolled stages, with
+ * nothing being loaded or stored in between but the samples. The same
+ * process1() of every stage runs in the same order, so the result is bit
+ * for bit that of filtering sample by sample.
+ *
+ */
+
+template <int NumStages, class StateType, class StageType>
+struct Unrolled
+{
+    template <int Index, int Dummy = 0>
+    struct Stage
+    {
+        static inline double process (double in, const StageType* stages, StateType* states)
+        {
+            return Stage<Index + 1>::process (states[Index].process1 (in, stages[Index]),
+                                              stages, states);
+        }
+    };
+    
+    template <int Dummy>
+    struct Stage<NumStages, Dummy>
+    {
+        static inline double process (double in, const StageType*, StateType*)
+        {
+            return in;
+        }
+    };
+    
+    static inline double process (double in, const StageType* stages, StateType* states)
+    {
+        return Stage<0>::process (in, stages, states);
+    }
+};
+
+template <int NumStages, class StateType, class StageType, typename Sample>
+void processUnrolled (int numSamples, Sample* dest,
+                      const StageType* stages, StateType* states)
+{
+    StageType stage[NumStages];
+    StateType state[NumStages];
+    for (int k = 0; k < NumStages; ++k)
+    {
+        stage[k] = stages[k];
+        state[k] = states[k];
+    }
+    
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = static_cast<Sample> (Unrolled<NumStages, StateType, StageType>::process (dest[i], stage, state));
+    
+    for (int k = 0; k < NumStages; ++k)
+        states[k] = state[k];
+}
+
+#endif
@@ -0,0 +1,458 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_STATEVARIABLE_H
+#define DSPFILTERS_STATEVARIABLE_H
+
+/*
+ * Topology-preserving (zero delay feedback) state variable filters,
+ * after Andrew Simper's "Linear Trapezoidal Integrated SVF":
+ *
+ * https://cytomic.com/files/dsp/SvfLinearTrapOptimised2.pdf
+ *
+ * The integrators hold the actual filter state, not past in- and
+ * outputs like the biquad direct forms do. Changing the coefficients
+ * between two samples therefore never produces a state that doesn't
+ * fit the new filter, which makes these safe for audio rate modulation
+ * without any smoothing. A redesign costs a single tan().
+ *
+ * Every section produces low pass, band pass and high pass outputs
+ * from one state update. All other responses are mixes of those.
+ *
+ */
+
+namespace StateVariable
+{
+    // Integrator states of one section
+    struct SectionState
+    {
+        SectionState ()
+        {
+            reset ();
+        }
+        
+        void reset ()
+        {
+            m_ic1eq = 0;
+            m_ic2eq = 0;
+        }
+        
+        double m_ic1eq;
+        double m_ic2eq;
+    };
+    
+//------------------------------------------------------------------------------
+    
+    // Coefficients of one two pole section, or of a one pole
+    // section when m_onePole is set. Output is m0*in + m1*band + m2*low.
+    struct Section
+    {
+        Section ()
+        {
+            setup (0.25, 1, 0, 0, 1);
+        }
+        
+        void setup (double g, double k, double m0, double m1, double m2)
+        {
+            m_onePole = false;
+            m_k  = k;
+            m_a1 = 1 / (1 + g * (g + k));
+            m_a2 = g * m_a1;
+            m_a3 = g * m_a2;
+            m_m0 = m0;
+            m_m1 = m1;
+            m_m2 = m2;
+        }
+        
+        // One pole sections only have the low and high pass outputs,
+        // mixed as m0*in + m2*low.
+        void setupOnePole (double g, double m0, double m2)
+        {
+            m_onePole = true;
+            m_k  = 0;
+            m_a1 = g / (1 + g);
+            m_a2 = 0;
+            m_a3 = 0;
+            m_m0 = m0;
+            m_m1 = 0;
+            m_m2 = m2;
+        }
+        
+        // Runs the section once and returns all three outputs. The band
+        // output is normalized to 0dB at the center, so that for two pole
+        // sections low + band + high always adds up to the input again.
+        inline void process (double in, SectionState& s,
+                             double& low, double& band, double& high) const
+        {
+            if (m_onePole)
+            {
+                const double v = (in - s.m_ic1eq) * m_a1;
+                low = v + s.m_ic1eq;
+                s.m_ic1eq = low + v;
+                band = 0;
+                high = in - low;
+            }
+            else
+            {
+                const double v3 = in - s.m_ic2eq;
+                const double v1 = m_a1 * s.m_ic1eq + m_a2 * v3;
+                const double v2 = s.m_ic2eq + m_a2 * s.m_ic1eq + m_a3 * v3;
+                s.m_ic1eq = 2 * v1 - s.m_ic1eq;
+                s.m_ic2eq = 2 * v2 - s.m_ic2eq;
+                low = v2;
+                band = m_k * v1;
+                high = in - band - low;
+            }
+        }
+        
+        inline double process (double in, SectionState& s) const
+        {
+            if (m_onePole)
+            {
+                const double v = (in - s.m_ic1eq) * m_a1;
+                const double low = v + s.m_ic1eq;
+                s.m_ic1eq = low + v;
+                return m_m0 * in + m_m2 * low;
+            }
+            else
+            {
+                const double v3 = in - s.m_ic2eq;
+                const double v1 = m_a1 * s.m_ic1eq + m_a2 * v3;
+                const double v2 = s.m_ic2eq + m_a2 * s.m_ic1eq + m_a3 * v3;
+                s.m_ic1eq = 2 * v1 - s.m_ic1eq;
+                s.m_ic2eq = 2 * v2 - s.m_ic2eq;
+                return m_m0 * in + m_m1 * v1 + m_m2 * v2;
+            }
+        }
+        
+        bool m_onePole;
+        double m_k;
+        double m_a1;
+        double m_a2;
+        double m_a3;
+        double m_m0;
+        double m_m1;
+        double m_m2;
+    };
+    
+//------------------------------------------------------------------------------
+    
+    // Serial chain of sections, each with its own state
+    template <int MaxStages>
+    class SectionCascade
+    {
+    public:
+        SectionCascade () : m_numStages (0)
+        {
+        }
+        
+        int getNumStages () const
+        {
+            return m_numStages;
+        }
+        
+        void reset ()
+        {
+            for (int i = 0; i < MaxStages; ++i)
+                m_states[i].reset ();
+        }
+        
+        // The integrator states fit any coefficients, so there's nothing
+        // to interpolate. A modulated redesign simply takes over.
+        void beginGlide ()
+        {
+        }
+        
+        void endGlide (int)
+        {
+        }
+        
+        double filter (double in)
+        {
+            double out = in;
+            for (int i = 0; i < m_numStages; ++i)
+                out = m_sections[i].process (out, m_states[i]);
+            return out;
+        }
+        
+    protected:
+        // Normalized frequency to integrator gain, the one tan() per design
+        static double prewarp (double sampleRate, double frequency)
+        {
+            return tan (doublePi * frequency / sampleRate);
+        }
+        
+        // Same section for all stages, for the RBJ style responses
+        void setStages (int stages, const Section& section)
+        {
+            assert (stages <= MaxStages);
+            m_numStages = stages;
+            for (int i = 0; i < stages; ++i)
+                m_sections[i] = section;
+        }
+        
+        int m_numStages;
+        Section m_sections[MaxStages];
+        SectionState m_states[MaxStages];
+    };
+    
+//------------------------------------------------------------------------------
+    
+    //
+    // Butterworth responses
+    //
+    // All sections share the same integrator gain and only differ in
+    // their damping, taken from the Butterworth pole angles. Odd orders
+    // get a one pole section at the end.
+    //
+    // Besides the regular low or high pass output, these can run all
+    // three outputs at once. The first section is shared by all outputs,
+    // so up to order 2 it's a single state update for all of them. From
+    // there on every output continues through sections of its own.
+    //
+    template <int MaxOrder>
+    class ButterworthBase : public SectionCascade <(MaxOrder + 1) / 2>
+    {
+    public:
+        typedef SectionCascade <(MaxOrder + 1) / 2> Base;
+        
+        void reset ()
+        {
+            Base::reset ();
+            for (int i = 0; i < (MaxOrder + 1) / 2; ++i)
+            {
+                m_bandStates[i].reset ();
+                m_highStates[i].reset ();
+            }
+        }
+        
+        // Low pass, band pass and high pass outputs in one go
+        void filter (double in, double& low, double& band, double& high)
+        {
+            double l, b, h;
+            
+            if (Base::m_numStages < 1)
+            {
+                low = in;
+                band = in;
+                high = in;
+                return;
+            }
+            
+            Base::m_sections[0].process (in, Base::m_states[0], low, band, high);
+            
+            for (int i = 1; i < Base::m_numStages; ++i)
+            {
+                const Section& section = Base::m_sections[i];
+                section.process (low, Base::m_states[i], low, b, h);
+                if (!section.m_onePole)
+                    section.process (band, m_bandStates[i], l, band, h);
+                section.process (high, m_highStates[i], l, b, high);
+            }
+        }
+        
+        double filter (double in)
+        {
+            return Base::filter (in);
+        }
+        
+    protected:
+        void design (int order, double sampleRate, double cutoffFrequency, bool highPass)
+        {
+            assert (order >= 1 && order <= MaxOrder);
+            
+            const double g = Base::prewarp (sampleRate, cutoffFrequency);
+            const double m0 = highPass ? 1. : 0.;
+            const double m2 = highPass ? -1. : 1.;
+            
+            const int pairs = order / 2;
+            for (int i = 0; i < pairs; ++i)
+            {
+                const double k = 2 * sin ((2 * i + 1) * doublePi / (2 * order));
+                Base::m_sections[i].setup (g, k, m0, highPass ? -k : 0., m2);
+            }
+            
+            if (order & 1)
+                Base::m_sections[pairs].setupOnePole (g, m0, m2);
+            
+            Base::m_numStages = pairs + (order & 1);
+        }
+        
+        // The first section's state is shared, so only the rest is used
+        SectionState m_bandStates[(MaxOrder + 1) / 2];
+        SectionState m_highStates[(MaxOrder + 1) / 2];
+    };
+    
+    template <int MaxOrder>
+    struct LowPass : ButterworthBase <MaxOrder>
+    {
+        void setup (int order, double sampleRate, double cutoffFrequency)
+        {
+            ButterworthBase <MaxOrder>::design (order, sampleRate, cutoffFrequency, false);
+        }
+    };
+    
+    // Runs through the high pass states, so calling the multi output
+    // filter() on it continues where the single output one left off.
+    template <int MaxOrder>
+    struct HighPass : ButterworthBase <MaxOrder>
+    {
+        typedef ButterworthBase <MaxOrder> Base;
+        
+        void setup (int order, double sampleRate, double cutoffFrequency)
+        {
+            Base::design (order, sampleRate, cutoffFrequency, true);
+        }
+        
+        void filter (double in, double& low, double& band, double& high)
+        {
+            Base::filter (in, low, band, high);
+        }
+        
+        double filter (double in)
+        {
+            if (Base::m_numStages < 1)
+                return in;
+            
+            // bounded by the section count as well, so the compiler can see
+            // a first order filter never goes past m_sections[0]
+            const int numStages = std::min (Base::m_numStages, (MaxOrder + 1) / 2);
+            
+            double out = Base::m_sections[0].process (in, Base::m_states[0]);
+            for (int i = 1; i < numStages; ++i)
+                out = Base::m_sections[i].process (out, Base::m_highStates[i]);
+            return out;
+        }
+    };
+    
+//------------------------------------------------------------------------------
+    
+    //
+    // RBJ responses
+    //
+    // Same curves as the Audio EQ Cookbook biquads, with the order being
+    // the number of identical sections in series, like RBJArray does it.
+    // The shelves and the bell take the gain in dB; the bell is what the
+    // cookbook calls a peaking EQ and this library calls a band shelf.
+    //
+    template <int MaxOrder>
+    struct BandPass : SectionCascade <MaxOrder>
+    {
+        // (constant 0 dB peak gain)
+        void setup (int order, double sampleRate, double centerFrequency, double q)
+        {
+            Section s;
+            const double k = 1 / q;
+            s.setup (SectionCascade <MaxOrder>::prewarp (sampleRate, centerFrequency), k, 0, k, 0);
+            SectionCascade <MaxOrder>::setStages (order, s);
+        }
+    };
+    
+    template <int MaxOrder>
+    struct BandStop : SectionCascade <MaxOrder>
+    {
+        void setup (int order, double sampleRate, double centerFrequency, double q)
+        {
+            Section s;
+            const double k = 1 / q;
+            s.setup (SectionCascade <MaxOrder>::prewarp (sampleRate, centerFrequency), k, 1, -k, 0);
+            SectionCascade <MaxOrder>::setStages (order, s);
+        }
+    };
+    
+    template <int MaxOrder>
+    struct AllPass : SectionCascade <MaxOrder>
+    {
+        void setup (int order, double sampleRate, double phaseFrequency, double q)
+        {
+            Section s;
+            const double k = 1 / q;
+            s.setup (SectionCascade <MaxOrder>::prewarp (sampleRate, phaseFrequency), k, 1, -2 * k, 0);
+            SectionCascade <MaxOrder>::setStages (order, s);
+        }
+    };
+    
+    template <int MaxOrder>
+    struct LowShelf : SectionCascade <MaxOrder>
+    {
+        void setup (int order, double sampleRate, double cutoffFrequency, double gainDb, double q)
+        {
+            Section s;
+            const double A = pow (10, gainDb / 40);
+            const double k = 1 / q;
+            s.setup (SectionCascade <MaxOrder>::prewarp (sampleRate, cutoffFrequency) / sqrt (A),
+                     k, 1, k * (A - 1), A * A - 1);
+            SectionCascade <MaxOrder>::setStages (order, s);
+        }
+    };
+    
+    template <int MaxOrder>
+    struct HighShelf : SectionCascade <MaxOrder>
+    {
+        void setup (int order, double sampleRate, double cutoffFrequency, double gainDb, double q)
+        {
+            Section s;
+            const double A = pow (10, gainDb / 40);
+            const double k = 1 / q;
+            s.setup (SectionCascade <MaxOrder>::prewarp (sampleRate, cutoffFrequency) * sqrt (A),
+                     k, A * A, k * (1 - A) * A, 1 - A * A);
+            SectionCascade <MaxOrder>::setStages (order, s);
+        }
+    };
+    
+    template <int MaxOrder>
+    struct BandShelf : SectionCascade <MaxOrder>
+    {
+        void setup (int order, double sampleRate, double centerFrequency, double gainDb, double q)
+        {
+            Section s;
+            const double A = pow (10, gainDb / 40);
+            const double k = 1 / (q * A);
+            s.setup (SectionCascade <MaxOrder>::prewarp (sampleRate, centerFrequency),
+                     k, 1, k * (A * A - 1), 0);
+            SectionCascade <MaxOrder>::setStages (order, s);
+        }
+    };
+    
+}
+
+#endif
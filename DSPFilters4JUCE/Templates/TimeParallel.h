@@ -0,0 +1,319 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef DSPFILTERS_TIMEPARALLEL_H
+#define DSPFILTERS_TIMEPARALLEL_H
+
+/*
+ * Time parallel offline filtering
+ *
+ * A cascade is a linear system, so what one segment of the signal does
+ * to the state is an affine map:
+ *
+ *   s[end] = A^L * s[start] + f
+ *
+ * A^L only depends on the coefficients and the segment length L, and f
+ * is the final state the segment leaves behind when started from zero.
+ *
+ * So the signal is cut into one segment per thread, and all segments run
+ * from zero state at the same time to find their f. A scan over the maps
+ * then chains the segments together, which yields the exact state every
+ * segment starts with. Finally all segments are filtered again, in
+ * parallel, from their true start states. Each thread does twice the work
+ * of a single one, the result matches serial processing to the last few
+ * bits of a double.
+ *
+ * The states are those of the regular state types, treated as one big
+ * vector through their getValues() and setValues().
+ *
+ */
+
+namespace TimeParallel
+{
+    template <int MaxStages, class StateType = DEFAULT_STATE>
+    class Offline
+    {
+    public:
+        enum
+        {
+            MaxValues = MaxStages * StateType::numValues
+        };
+        
+        Offline ()
+        : m_numStages (0)
+        , m_transitionLength (0)
+        , m_minSegmentLength (16384)
+        {
+        }
+        
+        // Copies the coefficients. The states are only reset
+        // if the coefficients are different from before.
+        void setup (const Biquad* stages, int numStages)
+        {
+            assert (numStages >= 0 && numStages <= MaxStages);
+            
+            bool changed = (numStages != m_numStages);
+            for (int i = 0; i < numStages && ! changed; ++i)
+                changed = ! stages[i].hasSameCoefficients (m_stages[i]);
+            
+            if (changed)
+            {
+                m_numStages = numStages;
+                for (int i = 0; i < numStages; ++i)
+                    m_stages[i] = stages[i];
+                
+                m_transitionLength = 0;
+                reset ();
+            }
+        }
+        
+        void setup (Cascade& cascade)
+        {
+            Biquad stages[MaxStages];
+            for (int i = 0; i < cascade.getNumStages (); ++i)
+                stages[i] = cascade[i];
+            
+            setup (stages, cascade.getNumStages ());
+        }
+        
+        void reset ()
+        {
+            for (int i = 0; i < MaxStages; ++i)
+                m_states[i].reset ();
+        }
+        
+        // Below this many samples per segment threads aren't worth it
+        void setMinSegmentLength (int samples)
+        {
+            assert (samples > 0);
+            m_minSegmentLength = samples;
+        }
+        
+        // Filters in place, carrying the state over from the previous call
+        // like a regular cascade would. Pass 0 threads to use all cores.
+        template <typename Sample>
+        void process (int numSamples, Sample* dest, int numThreads = 0)
+        {
+            if (numThreads < 1)
+                numThreads = std::max (1, static_cast<int> (std::thread::hardware_concurrency ()));
+            
+            const int maxSegments = std::min (numThreads, numSamples / m_minSegmentLength);
+            
+            if (maxSegments < 2 || m_numStages == 0)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    dest[i] = static_cast<Sample> (filter (m_states, dest[i]));
+                return;
+            }
+            
+            const int numValues = m_numStages * StateType::numValues;
+            const int length = (numSamples + maxSegments - 1) / maxSegments;
+            
+            // rounding the length up can leave fewer segments, and all
+            // but the last one have to be whole
+            const int numSegments = (numSamples + length - 1) / length;
+            
+            // all segments from zero state, only their final states are kept
+            std::vector<double> finals (numSegments * numValues);
+            
+            parallelFor (numSegments - 1, [&](int segment)
+            {
+                StateType states[MaxStages];
+                
+                const Sample* data = dest + segment * length;
+                for (int i = 0; i < length; ++i)
+                    filter (states, data[i]);
+                
+                getValues (states, &finals[segment * numValues]);
+            });
+            
+            // chain them up, each start state is the map of the one before
+            prepareTransition (length);
+            
+            std::vector<double> starts (numSegments * numValues);
+            getValues (m_states, &starts[0]);
+            
+            for (int segment = 1; segment < numSegments; ++segment)
+            {
+                const double* previous = &starts[(segment - 1) * numValues];
+                const double* zeroState = &finals[(segment - 1) * numValues];
+                double* start = &starts[segment * numValues];
+                
+                for (int row = 0; row < numValues; ++row)
+                {
+                    double sum = zeroState[row];
+                    for (int col = 0; col < numValues; ++col)
+                        sum += m_transition[row * numValues + col] * previous[col];
+                    start[row] = sum;
+                }
+            }
+            
+            // the real thing, the last segment hands its state back to us
+            parallelFor (numSegments, [&](int segment)
+            {
+                StateType* states = m_states;
+                StateType segmentStates[MaxStages];
+                if (segment < numSegments - 1)
+                {
+                    setValues (segmentStates, &starts[segment * numValues]);
+                    states = segmentStates;
+                }
+                else
+                {
+                    setValues (m_states, &starts[segment * numValues]);
+                }
+                
+                Sample* data = dest + segment * length;
+                const int end = std::min (length, numSamples - segment * length);
+                for (int i = 0; i < end; ++i)
+                    data[i] = static_cast<Sample> (filter (states, data[i]));
+            });
+        }
+        
+    private:
+        inline double filter (StateType* states, double in) const
+        {
+            for (int i = 0; i < m_numStages; ++i)
+                in = states[i].process1 (in, m_stages[i]);
+            return in;
+        }
+        
+        void getValues (StateType* states, double* values) const
+        {
+            for (int i = 0; i < m_numStages; ++i)
+            {
+                prepareState (states[i], m_stages[i]);
+                states[i].getValues (values + i * StateType::numValues);
+            }
+        }
+        
+        void setValues (StateType* states, const double* values) const
+        {
+            for (int i = 0; i < m_numStages; ++i)
+            {
+                prepareState (states[i], m_stages[i]);
+                states[i].setValues (values + i * StateType::numValues);
+            }
+        }
+        
+        // A^length, found by squaring the state transition of one sample.
+        void prepareTransition (int length)
+        {
+            if (length == m_transitionLength)
+                return;
+            
+            const int n = m_numStages * StateType::numValues;
+            
+            // one sample of zero input from each unit state gives a column of A
+            std::vector<double> step (n * n);
+            double unit[MaxValues];
+            double column[MaxValues];
+            for (int col = 0; col < n; ++col)
+            {
+                StateType states[MaxStages];
+                for (int i = 0; i < n; ++i)
+                    unit[i] = (i == col) ? 1 : 0;
+                
+                setValues (states, unit);
+                filter (states, 0);
+                getValues (states, column);
+                
+                for (int row = 0; row < n; ++row)
+                    step[row * n + col] = column[row];
+            }
+            
+            m_transition.assign (n * n, 0);
+            for (int i = 0; i < n; ++i)
+                m_transition[i * n + i] = 1;
+            
+            for (int bits = length; bits > 0; bits >>= 1)
+            {
+                if (bits & 1)
+                    multiply (m_transition, step, n);
+                multiply (step, step, n);
+            }
+            
+            m_transitionLength = length;
+        }
+        
+        // a = a * b for n x n matrices
+        static void multiply (std::vector<double>& a, const std::vector<double>& b, int n)
+        {
+            std::vector<double> result (n * n);
+            for (int row = 0; row < n; ++row)
+            {
+                for (int col = 0; col < n; ++col)
+                {
+                    double sum = 0;
+                    for (int k = 0; k < n; ++k)
+                        sum += a[row * n + k] * b[k * n + col];
+                    result[row * n + col] = sum;
+                }
+            }
+            a.swap (result);
+        }
+        
+        // Runs function(i) for i in [0, count), one thread each
+        template <typename Function>
+        static void parallelFor (int count, Function function)
+        {
+            std::vector<std::thread> threads;
+            for (int i = 1; i < count; ++i)
+                threads.push_back (std::thread (function, i));
+            
+            if (count > 0)
+                function (0);
+            
+            for (size_t i = 0; i < threads.size (); ++i)
+                threads[i].join ();
+        }
+        
+        int m_numStages;
+        int m_transitionLength;
+        int m_minSegmentLength;
+        Biquad m_stages[MaxStages];
+        StateType m_states[MaxStages];
+        std::vector<double> m_transition;
+    };
+}
+
+#endif
@@ -83,10 +83,46 @@ namespace DSPFILTERS
 #include "Shared/RootFinder.h"
 #endif
         
+#ifndef DSPFILTERS_CPUFEATURES_H
+#include "Shared/CpuFeatures.h"
+#endif
+        
 #ifndef DSPFILTERS_BIQUAD_H
 #include "Shared/Biquad.h"
 #endif
         
+#ifndef DSPFILTERS_RAMP_H
+#include "Shared/Ramp.h"
+#endif
+        
+#ifndef DSPFILTERS_BLOCKKERNEL_H
+#include "Shared/BlockKernel.h"
+#endif
+        
+#ifndef DSPFILTERS_PIPELINE_H
+#include "Shared/Pipeline.h"
+#endif
+        
+#ifndef DSPFILTERS_UNROLLED_H
+#include "Shared/Unrolled.h"
+#endif
+        
+#ifndef DSPFILTERS_STATE_H
+#include "Shared/State.h"
+#endif
+        
+#ifndef DSPFILTERS_STRUCTUREDKERNEL_H
+#include "Shared/StructuredKernel.h"
+#endif
+        
+#ifndef DSPFILTERS_STAGEMETER_H
+#include "Shared/StageMeter.h"
+#endif
+        
+#ifndef DSPFILTERS_PCM_H
+#include "Shared/Pcm.h"
+#endif
+        
 #ifndef DSPFILTERS_RBJ_H
 #include "RBJ.h"
 #endif
@@ -95,10 +131,6 @@ namespace DSPFILTERS
 #include "Shared/Cascade.h"
 #endif
         
-#ifndef DSPFILTERS_STATE_H
-#include "Shared/State.h"
-#endif
-        
 #ifndef DSPFILTERS_POLEFILTER_H
 #include "Shared/PoleFilter.h"
 #endif
@@ -126,6 +158,38 @@ namespace DSPFILTERS
 #ifndef DSPFILTERS_LEGENDRE_H
 #include "Legendre.h"
 #endif
+        
+#ifndef DSPFILTERS_STATEVARIABLE_H
+#include "StateVariable.h"
+#endif
+        
+#ifndef DSPFILTERS_LINKWITZRILEY_H
+#include "LinkwitzRiley.h"
+#endif
+        
+#ifndef DSPFILTERS_HALFBAND_H
+#include "Halfband.h"
+#endif
+        
+#ifndef DSPFILTERS_FILTFILT_H
+#include "FiltFilt.h"
+#endif
+        
+#ifndef DSPFILTERS_TIMEPARALLEL_H
+#include "TimeParallel.h"
+#endif
+        
+#ifndef DSPFILTERS_PARALLELFORM_H
+#include "ParallelForm.h"
+#endif
+        
+#ifndef DSPFILTERS_FIXEDPOINT_H
+#include "FixedPoint.h"
+#endif
+        
+#ifndef DSPFILTERS_INTERLEAVED_H
+#include "Interleaved.h"
+#endif
 
         
 /* --------------- END OF INCLUSIONS --------------- */
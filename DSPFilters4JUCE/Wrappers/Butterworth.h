@@ -100,6 +100,16 @@ public:
     double getFrequency()   {return SKELETON<CUR_FILT_NAME,Type,Order>::getFrequency();}
     double getWidth()       {return SKELETON<CUR_FILT_NAME,Type,Order>::getWidth();}
     double getGain()        {return SKELETON<CUR_FILT_NAME,Type,Order>::getGain();}
+
+    void setControlRate (int samples)   {SKELETON<CUR_FILT_NAME,Type,Order>::setControlRate(samples);}
+    int  getControlRate ()              {return SKELETON<CUR_FILT_NAME,Type,Order>::getControlRate();}
+    
+    void   setMultirate (int factor)    {SKELETON<CUR_FILT_NAME,Type,Order>::setMultirate(factor);}
+    int    getMultirate ()              {return SKELETON<CUR_FILT_NAME,Type,Order>::getMultirate();}
+    double getLatency ()                {return SKELETON<CUR_FILT_NAME,Type,Order>::getLatency();}
+    
+    void setParallelForm (bool parallel){SKELETON<CUR_FILT_NAME,Type,Order>::setParallelForm(parallel);}
+    bool getParallelForm ()             {return SKELETON<CUR_FILT_NAME,Type,Order>::getParallelForm();}
     
     // --------------------------------------------------------------------------------- //
     //
@@ -147,14 +157,14 @@ public:
                                                   SKELETON<CUR_FILT_NAME,Type,Order>::filterRolloff);
     }
     
-    
     // --------------------------------------------------------------------------------- //
     //
     //          PROCESSING ROUTINES
     //
     // --------------------------------------------------------------------------------- //
     //
-    //  Use these to let an entire AudioSampleBuffer be filtered.
+    //  Use these to let an entire AudioSampleBuffer or ChannelSpan be filtered.
+    //  An AudioBuffer<double> (or double ChannelSpan) is filtered in double.
     //
     //  Call anywhere in processBlock() to apply.
     //
@@ -172,13 +182,13 @@ public:
     // --------------------------------------------------------------------------------- //
     
     //  process only -- make sure the filter is set up correctly!
-    void process (AudioSampleBuffer* stream)
+    void process (ChannelSpan stream)
     {
         SKELETON<CUR_FILT_NAME,Type,Order>::process(stream);
     }
     
     //  quick one
-    void process (AudioSampleBuffer* stream, double SR, double Hz)
+    void process (ChannelSpan stream, double SR, double Hz)
     {
         SKELETON<CUR_FILT_NAME,Type,Order>::process(stream,SR,Hz,
                                                     SKELETON<CUR_FILT_NAME,Type,Order>::filterWidth,
@@ -188,7 +198,7 @@ public:
     }
     
     //  universal one
-    void process (AudioSampleBuffer* stream, double SR, double Hz, double Width, double dB)
+    void process (ChannelSpan stream, double SR, double Hz, double Width, double dB)
     {
         SKELETON<CUR_FILT_NAME,Type,Order>::process(stream,SR,Hz,
                                                     Width,
@@ -197,6 +207,243 @@ public:
                                                     SKELETON<CUR_FILT_NAME,Type,Order>::filterRolloff);
     }
     
+    // --------------------------------------------------------------------------------- //
+    //
+    //          INTERLEAVED ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to filter interleaved audio in place, like L R L R...
+    //  straight from a sound card, a host or an audio file, without
+    //  splitting it into an AudioSampleBuffer first.
+    //
+    //  Keeps its own filter states, so don't mix with process(&buffer).
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::Butterworth<LOWPASS,4> filter;       @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ PluginProcessor.cpp (anywhere)
+    //     filter.process(frames,numFrames,2);              @ anywhere
+    //
+    //  -> frames is a float or double array with numFrames x 2 samples, L R L R...
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  interleaved one
+    void process (float* interleaved, int numFrames, int numChannels)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(interleaved,numFrames,numChannels);
+    }
+    
+    //  interleaved one, in double
+    void process (double* interleaved, int numFrames, int numChannels)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(interleaved,numFrames,numChannels);
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          OUT OF PLACE ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to read one buffer and write the filtered signal into another,
+    //  so the dry signal stays as it was, without copying it first.
+    //
+    //  The ranged ones filter numChannels x numSamples from the given start
+    //  channels and samples on, input and output can be of different sizes.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::Butterworth<LOWPASS,4> filter;       @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ PluginProcessor.cpp (anywhere)
+    //     filter.process(buffer,wetBuffer);                @ PluginProcessor.cpp (anywhere)
+    //
+    //  -> wetBuffer has to have as many channels and samples as buffer
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  out of place one
+    void process (ChannelSpan input, ChannelSpan output)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output);
+    }
+    
+    //  ranged one
+    void process (ChannelSpan input, int inputChannel, int inputSample, ChannelSpan output, int outputChannel, int outputSample, int numChannels, int numSamples)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,inputChannel,inputSample,output,outputChannel,outputSample,numChannels,numSamples);
+    }
+    
+    //  raw pointer one
+    void process (const float* const* input, float* const* output, int numChannels, int numSamples, int inputSample=0, int outputSample=0)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output,numChannels,numSamples,inputSample,outputSample);
+    }
+    
+    //  raw pointer one, in double
+    void process (const double* const* input, double* const* output, int numChannels, int numSamples, int inputSample=0, int outputSample=0)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output,numChannels,numSamples,inputSample,outputSample);
+    }
+    
+#if DSPFILTERS_JUCE
+    //  out of place one, with AudioSampleBuffers
+    void process (const AudioSampleBuffer& input, AudioSampleBuffer& output)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output);
+    }
+    
+    //  ranged one, with AudioSampleBuffers
+    void process (const AudioSampleBuffer& input, int inputChannel, int inputSample, AudioSampleBuffer& output, int outputChannel, int outputSample, int numChannels, int numSamples)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,inputChannel,inputSample,output,outputChannel,outputSample,numChannels,numSamples);
+    }
+    
+    //  out of place one, with AudioBuffer<double>s
+    void process (const AudioBuffer<double>& input, AudioBuffer<double>& output)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output);
+    }
+    
+    //  ranged one, with AudioBuffer<double>s
+    void process (const AudioBuffer<double>& input, int inputChannel, int inputSample, AudioBuffer<double>& output, int outputChannel, int outputSample, int numChannels, int numSamples)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,inputChannel,inputSample,output,outputChannel,outputSample,numChannels,numSamples);
+    }
+#endif
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          MODULATION ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to sweep the filter with one value per sample, for
+    //  example from an LFO or an envelope follower.
+    //
+    //  The filter is only redesigned every getControlRate() samples
+    //  and glides smoothly in between, which is A LOT cheaper than
+    //  passing new settings into process() for every single sample.
+    //
+    //  Pass nullptr for parameters you don't want to modulate.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::Butterworth<LOWPASS,4> filter;       @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ PluginProcessor.cpp (anywhere)
+    //     filter.setControlRate(16);                       @ PluginProcessor.cpp (anywhere)
+    //     filter.process(&buffer,cutoffs);                 @ PluginProcessor.cpp (anywhere)
+    //
+    //  -> cutoffs is a float array with one frequency in Hz per sample
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  modulated one
+    void process (ChannelSpan stream, const float* cutoffModulation, const float* widthModulation=nullptr, const float* gainModulation=nullptr)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(stream,cutoffModulation,widthModulation,gainModulation);
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          ZERO PHASE ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to filter entire files offline without any phase shift.
+    //
+    //  The filter runs forward and then backward, so its magnitude response
+    //  is applied twice. NOT for processBlock(), these need the whole signal.
+    //
+    //  Files too long for memory go through processZeroPhaseChunk() piece by
+    //  piece, delayed by getZeroPhaseLatency() samples. After the last chunk,
+    //  flushZeroPhase() writes out the rest and returns how many samples.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::Butterworth<LOWPASS,4> filter;       @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ anywhere offline
+    //     filter.setZeroPhaseThreads();                    @ anywhere offline (optional)
+    //     filter.processZeroPhase(&buffer);                @ anywhere offline
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  whole buffer, in place
+    void processZeroPhase (ChannelSpan stream)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::processZeroPhase(stream);
+    }
+    
+    //  chunked, for very long files
+    void processZeroPhaseChunk (ChannelSpan stream)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::processZeroPhaseChunk(stream);
+    }
+    
+    int flushZeroPhase (ChannelSpan stream)
+    {
+        return SKELETON<CUR_FILT_NAME,Type,Order>::flushZeroPhase(stream);
+    }
+    
+    int getZeroPhaseLatency ()
+    {
+        return SKELETON<CUR_FILT_NAME,Type,Order>::getZeroPhaseLatency();
+    }
+    
+    //  bigger blocks mean more memory and latency, but fewer overlaps
+    void setZeroPhaseBlockLength (int samples)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::setZeroPhaseBlockLength(samples);
+    }
+    
+    //  worker threads for the channels, started right here instead of on first use
+    void setZeroPhaseThreads (int numThreads=0)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::setZeroPhaseThreads(numThreads);
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          TIME PARALLEL ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to render long files offline on all cores at once.
+    //
+    //  Same result as process(), but every channel is cut into segments
+    //  that are filtered at the same time. Only worth it for buffers of a
+    //  few hundred thousand samples or more, NOT for processBlock().
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::Butterworth<LOWPASS,4> filter;       @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ anywhere offline
+    //     filter.processTimeParallel(&buffer);             @ anywhere offline
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  pass 0 threads to use all cores
+    void processTimeParallel (ChannelSpan stream, int numThreads=0)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::processTimeParallel(stream,numThreads);
+    }
+    
 };
 
 
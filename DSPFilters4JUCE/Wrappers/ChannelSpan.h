@@ -0,0 +1,166 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef WRAPPER_CHANNELSPAN_H_INCLUDED
+#define WRAPPER_CHANNELSPAN_H_INCLUDED
+
+//
+//  CHANNEL SPAN
+//  ============
+//
+//  The audio every wrapper works on: numChannels arrays of numSamples floats
+//  or doubles each, which belong to somebody else. A span doesn't own, copy or
+//  allocate anything, so it's fine to make a new one for every block, around
+//  whatever buffer type your code uses.
+//
+//  With JUCE, an AudioSampleBuffer* or AudioBuffer<double>* turns into a span
+//  all by itself. So all the process() calls taking a ChannelSpan happily take
+//  &buffer as well.
+//
+//  Double spans are filtered in double all the way, the filter states are
+//  double anyway. There's no rounding to float in between, so a double
+//  precision host or mastering chain doesn't need to convert anything.
+//
+//  EXAMPLE (no JUCE):
+//
+//     float* channels[2]={left,right};
+//     filter.process(DSPFILTERS::ChannelSpan(channels,2,numSamples));
+//
+class ChannelSpan
+{
+public:
+    
+    ChannelSpan () {}
+    
+    ChannelSpan (float* const* channels, int numChannels, int numSamples)
+    : floatPointers(channels), channelCount(numChannels), sampleCount(numSamples)
+    {
+        jassert(numChannels>=0 and numSamples>=0);
+        jassert(channels!=nullptr or numChannels==0);
+    }
+    
+    ChannelSpan (double* const* channels, int numChannels, int numSamples)
+    : doublePointers(channels), channelCount(numChannels), sampleCount(numSamples)
+    {
+        jassert(numChannels>=0 and numSamples>=0);
+        jassert(channels!=nullptr or numChannels==0);
+    }
+    
+    //  For the optional outputs, like the bands of a Crossover.
+    ChannelSpan (std::nullptr_t) {}
+    
+#if DSPFILTERS_JUCE
+    ChannelSpan (AudioSampleBuffer* buffer)
+    {
+        if(buffer!=nullptr)
+        {
+            floatPointers=buffer->getArrayOfWritePointers();
+            channelCount=buffer->getNumChannels();
+            sampleCount=buffer->getNumSamples();
+        }
+    }
+    
+    ChannelSpan (AudioBuffer<double>* buffer)
+    {
+        if(buffer!=nullptr)
+        {
+            doublePointers=buffer->getArrayOfWritePointers();
+            channelCount=buffer->getNumChannels();
+            sampleCount=buffer->getNumSamples();
+        }
+    }
+#endif
+    
+    int getNumChannels () const {return channelCount;}
+    int getNumSamples  () const {return sampleCount;}
+    
+    //  True if this points at doubles instead of floats.
+    bool isDouble () const {return doublePointers!=nullptr;}
+    
+    //  These only work on float spans, a double span gives nullptr.
+    float* getWritePointer (int channel) const
+    {
+        jassert(channel>=0 and channel<channelCount);
+        float* const* floats=getChannels<float>();
+        return (floats!=nullptr) ? floats[channel] : nullptr;
+    }
+    
+    const float* getReadPointer (int channel) const
+    {
+        return getWritePointer(channel);
+    }
+    
+    float* const* getArrayOfWritePointers () const {return getChannels<float>();}
+    
+    //  For code that handles both sample types, check isDouble() first.
+    //  Asking for the other sample type than the span holds gives nullptr,
+    //  so bail out on that instead of reading someone else's memory.
+    template <typename Sample>
+    Sample* const* getChannels () const
+    {
+        return channels((Sample*)nullptr);
+    }
+    
+    //  True if this doesn't point at any audio, like a nullptr output.
+    bool isNull () const {return floatPointers==nullptr and doublePointers==nullptr;}
+    
+private:
+    
+    float* const* channels (float*) const
+    {
+        jassert(doublePointers==nullptr);
+        return (doublePointers==nullptr) ? floatPointers : nullptr;
+    }
+    
+    double* const* channels (double*) const
+    {
+        jassert(floatPointers==nullptr);
+        return (floatPointers==nullptr) ? doublePointers : nullptr;
+    }
+    
+    float* const* floatPointers=nullptr;
+    double* const* doublePointers=nullptr;
+    int channelCount=0;
+    int sampleCount=0;
+};
+
+#endif // WRAPPER_CHANNELSPAN_H_INCLUDED
@@ -0,0 +1,202 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+
+#ifndef WRAPPER_CHANNELWORKERS_H_INCLUDED
+#define WRAPPER_CHANNELWORKERS_H_INCLUDED
+
+//
+//  CHANNEL WORKERS
+//  ===============
+//
+//  A handful of threads that stay around for spreading channels over cores.
+//  Starting a thread takes a while, so the zero phase routines don't start
+//  new ones for every chunk. They hand their channels to these instead, which
+//  sleep in between. The calling thread pitches in as well, so numThreads-1
+//  workers are started for numThreads threads in total.
+//
+//  Starting and stopping allocates, so do that outside of any audio callback.
+//
+class ChannelWorkers
+{
+public:
+    
+    ChannelWorkers () {}
+    
+    ~ChannelWorkers () {stop();}
+    
+    //  Pass 0 threads to use all cores, 1 runs everything on the calling thread.
+    void start (int numThreads)
+    {
+        stop();
+        
+        if(numThreads<1)
+        {
+            numThreads=jmax(1,(int)std::thread::hardware_concurrency());
+        }
+        
+        for(int thread=1;thread<numThreads;++thread)
+        {
+            threads.push_back(std::thread(&ChannelWorkers::work,this,generation));
+        }
+        
+        started=true;
+    }
+    
+    void stop ()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit=true;
+        }
+        
+        wake.notify_all();
+        
+        for(size_t thread=0;thread<threads.size();++thread)
+        {
+            threads[thread].join();
+        }
+        
+        threads.clear();
+        quit=false;
+        started=false;
+    }
+    
+    bool isStarted ()     const {return started;}
+    int  getNumThreads () const {return (int)threads.size()+1;}
+    
+    //  Runs function(index) for every index from 0 to count-1, spread over the
+    //  workers and the calling thread, and returns once they're all done.
+    template <typename Function>
+    void run (int count, Function function)
+    {
+        if(threads.empty() or count<2)
+        {
+            for(int index=0;index<count;++index)
+            {
+                function(index);
+            }
+            return;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobFunction=&callJob<Function>;
+            jobContext=&function;
+            jobCount=count;
+            nextIndex.store(0);
+            busy=(int)threads.size();
+            ++generation;
+        }
+        
+        wake.notify_all();
+        
+        runJob();
+        
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock,[this] {return busy==0;});
+    }
+    
+private:
+    
+    template <typename Function>
+    static void callJob (void* context, int index)
+    {
+        (*(Function*)context)(index);
+    }
+    
+    //  Everybody takes the next index until there are none left.
+    void runJob ()
+    {
+        for(int index=nextIndex++;index<jobCount;index=nextIndex++)
+        {
+            jobFunction(jobContext,index);
+        }
+    }
+    
+    void work (unsigned int seen)
+    {
+        for(;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock,[&] {return quit or generation!=seen;});
+                
+                if(quit)
+                {
+                    return;
+                }
+                
+                seen=generation;
+            }
+            
+            runJob();
+            
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --busy;
+            }
+            
+            done.notify_one();
+        }
+    }
+    
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    
+    void (*jobFunction)(void*,int)=nullptr;
+    void* jobContext=nullptr;
+    int jobCount=0;
+    std::atomic<int> nextIndex{0};
+    
+    int busy=0;                     // workers still on the current job
+    unsigned int generation=0;      // counts the jobs, wakes the workers
+    bool quit=false;
+    bool started=false;
+    
+    ChannelWorkers (const ChannelWorkers&)=delete;
+    ChannelWorkers& operator= (const ChannelWorkers&)=delete;
+};
+
+#endif // WRAPPER_CHANNELWORKERS_H_INCLUDED
@@ -0,0 +1,365 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef WRAPPER_CROSSOVER_H_INCLUDED
+#define WRAPPER_CROSSOVER_H_INCLUDED
+
+//
+//  LINKWITZ-RILEY CROSSOVER
+//  ========================
+//
+//    Template arguments
+//    ------------------
+//
+//      Bands           number of bands to split into, at least 2
+//      Order           Linkwitz-Riley order: 2, 4, 6 or 8 (LR2, LR4, LR6, LR8)
+//
+//
+//  Splits a buffer into several frequency bands, lowest first.
+//  The bands are phase aligned, so if you add them all back together you
+//  get a flat frequency response. Perfect for multiband dynamics.
+//
+//  All bands are calculated in one go, so this is a lot cheaper than having
+//  a bunch of Butterworth low and high passes plus the phase correction.
+//
+//  Unlike the other filters, this doesn't filter the stream in place. The
+//  bands go into separate buffers, see process() further down.
+//
+//  Default number of bands and order if template arguments not given (feel free to change)
+#define CUR_DFLT_BNDS 3
+#define CUR_DFLT_ORDR 4
+// ------------------------------------------------------------------------------------- //
+
+template<unsigned int Bands=CUR_DFLT_BNDS, unsigned int Order=CUR_DFLT_ORDR>
+class Crossover
+{
+public:
+    
+    Crossover ()
+    {
+        static_assert(Bands>=2,"A crossover needs at least 2 bands");
+        static_assert(Order>=2 and Order<=8 and (Order%2)==0,"Linkwitz-Riley orders are 2, 4, 6 or 8");
+        
+        for(unsigned int split=0;split<Bands-1;++split)
+        {
+            filterFrequency[split]=0.0;
+        }
+    }
+    
+    ~Crossover () {}
+    
+    //
+    //  PARAMETER SETTER and GETTER methods
+    //
+    //  There are Bands-1 split frequencies, the first one being between
+    //  band 0 and band 1. They need to go up from one split to the next.
+    //
+    void setSampleRate  (double SR)             {if(SR!=filterSampleRate){filterSampleRate=SR;coeffsUpdated=true;}}
+    void setFrequency   (int split, double Hz)  {jassert(split>=0 and split<(int)Bands-1);if(Hz!=filterFrequency[split]){filterFrequency[split]=Hz;coeffsUpdated=true;}}
+    
+    double getSampleRate()              {return filterSampleRate;}
+    double getFrequency(int split)      {jassert(split>=0 and split<(int)Bands-1);return filterFrequency[split];}
+    int    getNumBands()                {return (int)Bands;}
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          SETUP ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to update the crossover's settings.
+    //
+    //  Don't be afraid to call these often, the filters
+    //  will only reset if the values actually change.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::Crossover<3,4> xover;                @ PluginProcessor.h file !!!
+    //
+    //     const double splits[2]={200.0,2000.0};           @ PluginProcessor.cpp (anywhere)
+    //     xover.setup(44100.0,splits);                     @ PluginProcessor.cpp (anywhere)
+    //
+    //  -> creates a 3 band LR4 crossover at 200 Hz and 2 kHz at SR 44.1 kHz
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  universal one -- Hz needs to hold Bands-1 frequencies
+    void setup (double SR, const double* Hz)
+    {
+        setSampleRate(SR);
+        
+        for(unsigned int split=0;split<Bands-1;++split)
+        {
+            setFrequency(split,Hz[split]);
+        }
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          PROCESSING ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to split an entire AudioSampleBuffer or ChannelSpan into bands.
+    //
+    //  The stream itself is left untouched, unless you pass it as one of the
+    //  bands. Every band buffer needs to have as many channels and samples as
+    //  the stream. Pass nullptr for bands you don't need, they still need to
+    //  be calculated for the others to sum up correctly though.
+    //
+    //  Works with AudioBuffer<double>s (or double ChannelSpans) just the same,
+    //  then the stream and all bands need to be doubles.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::Crossover<3,4> xover;                @ PluginProcessor.h file !!!
+    //     AudioSampleBuffer low,mid,high;                  @ PluginProcessor.h file !!!
+    //
+    //     AudioSampleBuffer* bands[3]={&low,&mid,&high};   @ PluginProcessor.cpp (anywhere)
+    //     xover.process(&buffer,bands);                    @ PluginProcessor.cpp (anywhere)
+    //     ---- or ----
+    //     xover.process(&buffer,bands,44100.0,splits);     @ PluginProcessor.cpp (anywhere)
+    //
+    //  -> without JUCE, bands is an array of 3 ChannelSpans instead
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  process only -- make sure the crossover is set up correctly!
+    void process (ChannelSpan stream, const ChannelSpan* bands)
+    {
+        if(stream.isDouble()) {processBands<double>(stream,bands);}
+        else                  {processBands<float>(stream,bands);}
+    }
+    
+    //  universal one
+    void process (ChannelSpan stream, const ChannelSpan* bands, double SR, const double* Hz)
+    {
+        setup(SR,Hz);
+        process(stream,bands);
+    }
+    
+#if DSPFILTERS_JUCE
+    //  process only, with AudioSampleBuffers for the bands
+    void process (AudioSampleBuffer* stream, AudioSampleBuffer** bands)
+    {
+        processBuffers(stream,bands);
+    }
+    
+    //  universal one, with AudioSampleBuffers for the bands
+    void process (AudioSampleBuffer* stream, AudioSampleBuffer** bands, double SR, const double* Hz)
+    {
+        setup(SR,Hz);
+        process(stream,bands);
+    }
+    
+    //  process only, with AudioBuffer<double>s for the bands
+    void process (AudioBuffer<double>* stream, AudioBuffer<double>** bands)
+    {
+        processBuffers(stream,bands);
+    }
+    
+    //  universal one, with AudioBuffer<double>s for the bands
+    void process (AudioBuffer<double>* stream, AudioBuffer<double>** bands, double SR, const double* Hz)
+    {
+        setup(SR,Hz);
+        process(stream,bands);
+    }
+#endif
+    
+private:
+    
+    //  The process() calls above end up here, with floats or doubles.
+    template <typename Sample>
+    void processBands (ChannelSpan stream, const ChannelSpan* bands)
+    {
+        const int numChannels=stream.getNumChannels();
+        const int numSamples=stream.getNumSamples();
+        
+        prepareFilters(numChannels);
+        updateFilters();
+        
+        jassert(filterSampleRate>0.0);
+        jassert(filterFrequency[0]>0.0);
+        jassert(!filterArray.isEmpty());
+        jassert(filterArray.size()==numChannels);
+        
+        Sample* const* streamChannels=stream.getChannels<Sample>();
+        Sample* const* bandChannels[Bands];
+        
+        if(streamChannels==nullptr)
+        {
+            return;
+        }
+        
+        for(unsigned int band=0;band<Bands;++band)
+        {
+            jassert(bands[band].isNull() or (bands[band].isDouble()==stream.isDouble() and bands[band].getNumChannels()==numChannels and bands[band].getNumSamples()==numSamples));
+            
+            //  A band of the other sample type can't be written, leave them all alone
+            bandChannels[band]=(!bands[band].isNull()) ? bands[band].getChannels<Sample>() : nullptr;
+            
+            if(!bands[band].isNull() and bandChannels[band]==nullptr)
+            {
+                return;
+            }
+        }
+        
+        for(int channel=0;channel<numChannels;++channel)
+        {
+            const Sample* channelData=streamChannels[channel];
+            
+            Sample* bandData[Bands];
+            
+            for(unsigned int band=0;band<Bands;++band)
+            {
+                bandData[band]=(bandChannels[band]!=nullptr) ? bandChannels[band][channel] : nullptr;
+            }
+            
+            DSPFILTERS::Templates::LinkwitzRiley::Crossover<Bands,Order>* channelFilter;
+            channelFilter=filterArray[channel];
+            
+            for(int sample=0;sample<numSamples;++sample)
+            {
+                double split[Bands];
+                
+                // All bands of this sample in one pass through the tree
+                channelFilter->filter((double)channelData[sample],split);
+                
+                for(unsigned int band=0;band<Bands;++band)
+                {
+                    if(bandData[band]!=nullptr) {bandData[band][sample]=(Sample)split[band];}
+                }
+            }
+        }
+    }
+    
+#if DSPFILTERS_JUCE
+    //  Helper for the AudioBuffer process() calls above.
+    template <typename Sample>
+    void processBuffers (AudioBuffer<Sample>* stream, AudioBuffer<Sample>** bands)
+    {
+        ChannelSpan bandSpans[Bands];
+        
+        for(unsigned int band=0;band<Bands;++band)
+        {
+            bandSpans[band]=bands[band];
+        }
+        
+        process(stream,bandSpans);
+    }
+#endif
+    
+    //
+    //  FILTER ARRAY that dynamically instantiates new or deletes old crossovers.
+    //
+    //  Holds one complete crossover per channel.
+    //
+    FilterArray<DSPFILTERS::Templates::LinkwitzRiley::Crossover<Bands,Order>> filterArray;
+    
+    bool coeffsUpdated=false;
+    
+    //
+    //  CROSSOVER SETTINGS
+    //
+    //  They all need a default value, shouldn't be undefined.
+    //
+    double filterSampleRate=0.0;            // in Hz
+    double filterFrequency[Bands-1];        // in Hz, set in the constructor
+    
+    //
+    //  FILTER ALLOCATION
+    //
+    //  Re-/populates the "one crossover for each channel" array.
+    //
+    void prepareFilters (int numChannels)
+    {
+        /* reset array if numFilters doesn't match numChannels */
+        if(!filterArray.isEmpty())
+        {
+            if(filterArray.size()!=numChannels)
+            {
+                filterArray.clear();
+            }
+        }
+        
+        /* if array empty then add numChannels crossover instances */
+        if(filterArray.isEmpty())
+        {
+            for(int channel=0;channel<numChannels;++channel)
+            {
+                filterArray.add(new DSPFILTERS::Templates::LinkwitzRiley::Crossover<Bands,Order>);
+            }
+            
+            // new crossovers don't know their settings yet
+            coeffsUpdated=true;
+        }
+    }
+    
+    //
+    //  If any settings have changed, re-calculate all crossovers.
+    //  If no settings have changed, nothing happens.
+    //
+    void updateFilters ()
+    {
+        if(coeffsUpdated==true)
+        {
+            for(int channel=0;channel<filterArray.size();++channel)
+            {
+                filterArray[channel]->reset();
+                filterArray[channel]->setup(Order,Bands,filterSampleRate,filterFrequency);
+            }
+            
+            coeffsUpdated=false;
+        }
+    }
+};
+
+
+// Leave these here to avoid compiler warnings
+#undef CUR_DFLT_BNDS
+#undef CUR_DFLT_ORDR
+
+#endif // WRAPPER_CROSSOVER_H_INCLUDED
@@ -0,0 +1,83 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef WRAPPER_FILTERARRAY_H_INCLUDED
+#define WRAPPER_FILTERARRAY_H_INCLUDED
+
+//
+//  FILTER ARRAY
+//  ============
+//
+//  Owns the per channel filters of the wrappers, and deletes them again.
+//  Does the few things of JUCE's OwnedArray the wrappers need, so that
+//  they don't need JUCE for it.
+//
+template <class Type>
+class FilterArray
+{
+public:
+    
+    FilterArray () {}
+    
+    int  size ()    const {return (int)objects.size();}
+    bool isEmpty () const {return objects.empty();}
+    
+    //  Takes over the object and deletes it when it's removed.
+    void add (Type* object) {objects.push_back(std::unique_ptr<Type>(object));}
+    
+    void clear () {objects.clear();}
+    
+    Type* operator[] (int index) const
+    {
+        jassert(index>=0 and index<size());
+        return objects[(size_t)index].get();
+    }
+    
+private:
+    
+    std::vector<std::unique_ptr<Type>> objects;
+    
+    FilterArray (const FilterArray&)=delete;
+    FilterArray& operator= (const FilterArray&)=delete;
+};
+
+#endif // WRAPPER_FILTERARRAY_H_INCLUDED
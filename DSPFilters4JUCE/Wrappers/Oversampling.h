@@ -0,0 +1,396 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef WRAPPER_OVERSAMPLING_H_INCLUDED
+#define WRAPPER_OVERSAMPLING_H_INCLUDED
+
+//
+//  OVERSAMPLING     (polyphase IIR halfband filters)
+//  ============
+//
+//    Template arguments
+//    ------------------
+//
+//      Factor          2, 4 or 8
+//
+//
+//  Gives your nonlinear processing (saturation, clipping, etc.) a higher
+//  sample rate to play in. Upsample the buffer, do your thing on the
+//  oversampled buffer, then downsample back into the original buffer.
+//
+//  The anti-aliasing filters are halfband allpass pairs that run at the
+//  lower rate of every 2x step, which is a lot cheaper than running an
+//  Elliptic low pass at the oversampled rate.
+//
+//  Default oversampling factor if template argument not given (feel free to change)
+#define CUR_DFLT_FCTR 2
+// ------------------------------------------------------------------------------------- //
+
+template<unsigned int Factor=CUR_DFLT_FCTR>
+class Oversampling
+{
+public:
+    
+    Oversampling ()
+    {
+        static_assert(Factor==2 or Factor==4 or Factor==8,"Oversampling factors are 2, 4 or 8");
+    }
+    
+    ~Oversampling () {}
+    
+    //
+    //  PARAMETER SETTER and GETTER methods
+    //
+    //  Attenuation is how far down the aliases end up, in positive dB.
+    //
+    //  Transition is the width of the band between pass and stop band,
+    //  relative to twice the original sample rate. At 0.01 and 44.1 kHz,
+    //  everything up to ~21 kHz passes and everything from ~23 kHz on is
+    //  attenuated. Wider transitions need fewer filter coefficients.
+    //
+    void setAttenuation (double dB)     {if(dB!=filterAttenuation){filterAttenuation=dB;coeffsUpdated=true;}}
+    void setTransition  (double Width)  {if(Width!=filterTransition){filterTransition=Width;coeffsUpdated=true;}}
+    
+    double getAttenuation() {return filterAttenuation;}
+    double getTransition()  {return filterTransition;}
+    int    getFactor()      {return (int)Factor;}
+    
+    //  Total delay of upsample() plus downsample(), in original samples.
+    //  Report this to your host with setLatencySamples() (rounded).
+    double getLatency()
+    {
+        DSPFILTERS::Templates::Halfband::Interpolator<> up;
+        DSPFILTERS::Templates::Halfband::Decimator<> down;
+        
+        up.setup(Factor,filterAttenuation,filterTransition);
+        down.setup(Factor,filterAttenuation,filterTransition);
+        
+        // The decimator counts its delay from the newest of the Factor samples
+        // it takes in, which is already (Factor-1)/Factor samples late.
+        return up.getDelay()+down.getDelay()-(Factor-1.0)/Factor;
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          SETUP ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  The defaults (100 dB, 0.01) are fine for most things,
+    //  you only need this if you want to trade quality for CPU.
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    void setup (double dB, double Width)
+    {
+        setAttenuation(dB);
+        setTransition(Width);
+    }
+    
+    //
+    //  Call this from prepareToPlay(), with the most channels and samples a block
+    //  will ever have. Sets up the filters and sizes the internal oversampled buffers
+    //  (float and double) up front, so upsample(&buffer) never allocates anything
+    //  on the audio thread. Blocks may be smaller than this, but never larger.
+    //
+    void prepare (int maxChannels, int maxBlockSize)
+    {
+        jassert(maxChannels>0 and maxBlockSize>0);
+        
+        prepareFilters(maxChannels);
+        updateFilters();
+        
+#if DSPFILTERS_JUCE
+        oversampledBuffer.setSize(maxChannels,maxBlockSize*(int)Factor,false,true,false);
+        oversampledDoubleBuffer.setSize(maxChannels,maxBlockSize*(int)Factor,false,true,false);
+#else
+        //  Without JUCE the caller brings the oversampled buffer
+        (void)maxBlockSize;
+#endif
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          PROCESSING ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  upsample() returns an internal buffer with Factor times as many samples
+    //  as the stream. Process that one, then downsample() it back into the
+    //  stream. Both need to be called with the same stream every block.
+    //  The internal buffers are sized by prepare(), so call that first. A block
+    //  larger than prepared for gets nullptr back and isn't touched at all.
+    //
+    //  Without JUCE, or to use your own buffer, pass the oversampled buffer
+    //  as a second ChannelSpan with Factor times as many samples.
+    //
+    //  An AudioBuffer<double> stream gets an AudioBuffer<double> back, and
+    //  is filtered in double all the way.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::Oversampling<4> oversampling;        @ PluginProcessor.h file !!!
+    //
+    //     oversampling.prepare(numChannels,samplesPerBlock);       @ prepareToPlay()
+    //
+    //     AudioSampleBuffer* os=oversampling.upsample(&buffer);    @ processBlock()
+    //     ... saturate os ...                                      @ processBlock()
+    //     oversampling.downsample(&buffer);                        @ processBlock()
+    //     ---- or ----
+    //     oversampling.upsample(stream,oversampled);               @ anywhere
+    //     ... saturate oversampled ...                             @ anywhere
+    //     oversampling.downsample(stream,oversampled);             @ anywhere
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    void upsample (ChannelSpan stream, ChannelSpan oversampled)
+    {
+        if(stream.isDouble()) {upsampleChannels<double>(stream,oversampled);}
+        else                  {upsampleChannels<float>(stream,oversampled);}
+    }
+    
+    void downsample (ChannelSpan stream, ChannelSpan oversampled)
+    {
+        if(stream.isDouble()) {downsampleChannels<double>(stream,oversampled);}
+        else                  {downsampleChannels<float>(stream,oversampled);}
+    }
+    
+#if DSPFILTERS_JUCE
+    AudioSampleBuffer* upsample (AudioSampleBuffer* stream)
+    {
+        return upsampleBuffer(stream,oversampledBuffer,oversampledView);
+    }
+    
+    void downsample (AudioSampleBuffer* stream)
+    {
+        downsampleBuffer(stream,oversampledView);
+    }
+    
+    AudioBuffer<double>* upsample (AudioBuffer<double>* stream)
+    {
+        return upsampleBuffer(stream,oversampledDoubleBuffer,oversampledDoubleView);
+    }
+    
+    void downsample (AudioBuffer<double>* stream)
+    {
+        downsampleBuffer(stream,oversampledDoubleView);
+    }
+#endif
+    
+private:
+    
+#if DSPFILTERS_JUCE
+    //  The buffer handed out is a view of this block's size into the prepared
+    //  one. Referring to other data doesn't allocate, unlike setSize().
+    template <typename Sample>
+    AudioBuffer<Sample>* upsampleBuffer (AudioBuffer<Sample>* stream, AudioBuffer<Sample>& prepared, AudioBuffer<Sample>& view)
+    {
+        const int numChannels=stream->getNumChannels();
+        const int numSamples=stream->getNumSamples()*(int)Factor;
+        
+        //  Larger than prepare() was told about
+        jassert(numChannels<=prepared.getNumChannels() and numSamples<=prepared.getNumSamples());
+        
+        if(numChannels>prepared.getNumChannels() or numSamples>prepared.getNumSamples())
+        {
+            return nullptr;
+        }
+        
+        view.setDataToReferTo(prepared.getArrayOfWritePointers(),numChannels,numSamples);
+        upsample(stream,&view);
+        return &view;
+    }
+    
+    template <typename Sample>
+    void downsampleBuffer (AudioBuffer<Sample>* stream, AudioBuffer<Sample>& view)
+    {
+        //  Not the stream the last upsample() got
+        jassert(view.getNumChannels()==stream->getNumChannels() and view.getNumSamples()==stream->getNumSamples()*(int)Factor);
+        
+        if(view.getNumChannels()!=stream->getNumChannels() or view.getNumSamples()!=stream->getNumSamples()*(int)Factor)
+        {
+            return;
+        }
+        
+        downsample(stream,&view);
+    }
+#endif
+    
+    //  The calls above end up here, with floats or doubles.
+    template <typename Sample>
+    void upsampleChannels (ChannelSpan stream, ChannelSpan oversampled)
+    {
+        const int numChannels=stream.getNumChannels();
+        const int numSamples=stream.getNumSamples();
+        
+        jassert(oversampled.isDouble()==stream.isDouble());
+        jassert(oversampled.getNumChannels()==numChannels);
+        jassert(oversampled.getNumSamples()==numSamples*(int)Factor);
+        
+        Sample* const* streamChannels=stream.getChannels<Sample>();
+        Sample* const* oversampledChannels=oversampled.getChannels<Sample>();
+        
+        if(streamChannels==nullptr or oversampledChannels==nullptr)
+        {
+            return;
+        }
+        
+        prepareFilters(numChannels);
+        updateFilters();
+        
+        for(int channel=0;channel<numChannels;++channel)
+        {
+            const Sample* channelData=streamChannels[channel];
+            Sample* oversampledData=oversampledChannels[channel];
+            
+            DSPFILTERS::Templates::Halfband::Interpolator<>* channelFilter;
+            channelFilter=upsamplers[channel];
+            
+            for(int sample=0;sample<numSamples;++sample)
+            {
+                channelFilter->process(channelData[sample],oversampledData+sample*Factor);
+            }
+        }
+    }
+    
+    template <typename Sample>
+    void downsampleChannels (ChannelSpan stream, ChannelSpan oversampled)
+    {
+        const int numChannels=stream.getNumChannels();
+        const int numSamples=stream.getNumSamples();
+        
+        jassert(downsamplers.size()>=numChannels);
+        jassert(oversampled.isDouble()==stream.isDouble());
+        jassert(oversampled.getNumChannels()==numChannels);
+        jassert(oversampled.getNumSamples()==numSamples*(int)Factor);
+        
+        Sample* const* streamChannels=stream.getChannels<Sample>();
+        Sample* const* oversampledChannels=oversampled.getChannels<Sample>();
+        
+        if(streamChannels==nullptr or oversampledChannels==nullptr)
+        {
+            return;
+        }
+        
+        for(int channel=0;channel<numChannels;++channel)
+        {
+            Sample* channelData=streamChannels[channel];
+            const Sample* oversampledData=oversampledChannels[channel];
+            
+            DSPFILTERS::Templates::Halfband::Decimator<>* channelFilter;
+            channelFilter=downsamplers[channel];
+            
+            for(int sample=0;sample<numSamples;++sample)
+            {
+                channelData[sample]=channelFilter->process(oversampledData+sample*Factor);
+            }
+        }
+    }
+    
+    //
+    //  FILTER ARRAYS, one up- and one downsampler per channel.
+    //
+    FilterArray<DSPFILTERS::Templates::Halfband::Interpolator<>> upsamplers;
+    FilterArray<DSPFILTERS::Templates::Halfband::Decimator<>> downsamplers;
+    
+#if DSPFILTERS_JUCE
+    AudioSampleBuffer oversampledBuffer;
+    AudioBuffer<double> oversampledDoubleBuffer;
+    AudioSampleBuffer oversampledView;
+    AudioBuffer<double> oversampledDoubleView;
+#endif
+    
+    bool coeffsUpdated=true;
+    
+    //
+    //  FILTER SETTINGS
+    //
+    //  They all need a default value, shouldn't be undefined.
+    //
+    double filterAttenuation=100.0;     // in dB
+    double filterTransition=0.01;       // relative to 2x sample rate
+    
+    //
+    //  FILTER ALLOCATION
+    //
+    //  Re-/populates the "one filter for each channel" arrays. Only ever grows them,
+    //  so blocks with fewer channels than prepare() was given don't reallocate.
+    //
+    void prepareFilters (int numChannels)
+    {
+        /* add filters if there are fewer than numChannels */
+        if(upsamplers.size()<numChannels)
+        {
+            for(int channel=upsamplers.size();channel<numChannels;++channel)
+            {
+                upsamplers.add(new DSPFILTERS::Templates::Halfband::Interpolator<>);
+                downsamplers.add(new DSPFILTERS::Templates::Halfband::Decimator<>);
+            }
+            
+            coeffsUpdated=true;
+        }
+    }
+    
+    void updateFilters ()
+    {
+        if(coeffsUpdated==true)
+        {
+            for(int channel=0;channel<upsamplers.size();++channel)
+            {
+                upsamplers[channel]->reset();
+                upsamplers[channel]->setup(Factor,filterAttenuation,filterTransition);
+                downsamplers[channel]->reset();
+                downsamplers[channel]->setup(Factor,filterAttenuation,filterTransition);
+            }
+            
+            coeffsUpdated=false;
+        }
+    }
+};
+
+
+// Leave this here to avoid compiler warnings
+#undef CUR_DFLT_FCTR
+
+#endif // WRAPPER_OVERSAMPLING_H_INCLUDED
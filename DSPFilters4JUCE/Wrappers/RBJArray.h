@@ -65,12 +65,18 @@ namespace Templates
         //  settings, the coeffsUpdated flag will be set. In the next process()
         //  if this flag is TRUE, filters will be reset and their values updated.
         //
-        void setup (double SR, double Hz, double Q, double dB)
+        //  If Glide is larger than 0, the filters will NOT be reset. Instead
+        //  their coefficients will travel to the new settings over the next
+        //  Glide samples. That's what the modulation inputs use.
+        //
+        void setup (double SR, double Hz, double Q, double dB, int Glide=0)
         {
             if(SR!=filterSampleRate){filterSampleRate=SR;coeffsUpdated=true;}
             if(Hz!=filterFrequency){filterFrequency=Hz;coeffsUpdated=true;}
             if(Q!=filterWidth){filterWidth=Q;coeffsUpdated=true;}
             if(dB!=filterGain){filterGain=dB;coeffsUpdated=true;}
+            
+            glideSamples=Glide;
         }
         
         //
@@ -101,6 +107,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*LPs[step]);}
                     filtered=LPs[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -111,6 +118,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*HPs[step]);}
                     filtered=HPs[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -121,6 +129,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*LSs[step]);}
                     filtered=LSs[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -131,6 +140,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*HSs[step]);}
                     filtered=HSs[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -141,6 +151,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*BP1s[step]);}
                     filtered=BP1s[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -151,6 +162,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*BP2s[step]);}
                     filtered=BP2s[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -161,6 +173,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*BSs[step]);}
                     filtered=BSs[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -171,6 +184,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*SHs[step]);}
                     filtered=SHs[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -181,6 +195,7 @@ namespace Templates
                 
                 for(unsigned int step=0;step<Order;++step)
                 {
+                    if(filterRamps[step]->isActive()){filterRamps[step]->step(*APs[step]);}
                     filtered=APs[step]->filter(filtered,*filterState[step]);
                 }
             }
@@ -188,10 +203,49 @@ namespace Templates
             return filtered;
         }
         
+        //
+        //  COPIES the current coefficients into a plain array of biquads,
+        //  for the offline engines that bring their own states, like the
+        //  zero phase one.
+        //
+        //  Returns the number of biquads copied, that's the Order.
+        //
+        int getStages (DSPFILTERS::Templates::Biquad* stages, int maxStages)
+        {
+            prepareFilters();
+            updateCoefficients();
+            
+            jassert(maxStages>=(int)Order);
+            
+            const int numStages=jmin((int)Order,maxStages);
+            
+            for(int step=0;step<numStages;++step)
+            {
+                // the copies keep these coefficients, they can't glide along
+                jassert(!filterRamps[step]->isActive());
+                
+                DSPFILTERS::Templates::BiquadBase& stage=stages[step];
+                
+                if      (Type==DSPFILTERS::FilterTypes::LOWPASS)   {stage=*LPs[step];}
+                else if (Type==DSPFILTERS::FilterTypes::HIGHPASS)  {stage=*HPs[step];}
+                else if (Type==DSPFILTERS::FilterTypes::LOWSHELF)  {stage=*LSs[step];}
+                else if (Type==DSPFILTERS::FilterTypes::HIGHSHELF) {stage=*HSs[step];}
+                else if (Type==DSPFILTERS::FilterTypes::BANDPASS)  {stage=*BP1s[step];}
+                else if (Type==DSPFILTERS::FilterTypes::BANDPASS2) {stage=*BP2s[step];}
+                else if (Type==DSPFILTERS::FilterTypes::BANDSTOP)  {stage=*BSs[step];}
+                else if (Type==DSPFILTERS::FilterTypes::BANDSHELF) {stage=*SHs[step];}
+                else if (Type==DSPFILTERS::FilterTypes::ALLPASS)   {stage=*APs[step];}
+            }
+            
+            return numStages;
+        }
+        
     private:
         
         bool coeffsUpdated=false;
         
+        int glideSamples=0;
+        
         //
         //  FILTER SETTINGS
         //
@@ -209,7 +263,14 @@ namespace Templates
         //
         //  This array holds one State per "order" filter.
         //
-        OwnedArray<DSPFILTERS::Templates::DEFAULT_STATE> filterState;// filter states buffer
+        FilterArray<DSPFILTERS::Templates::DEFAULT_STATE> filterState;// filter states buffer
+        
+        //
+        //  COEFFICIENT RAMPS
+        //
+        //  One per "order" filter, only active while gliding.
+        //
+        FilterArray<DSPFILTERS::Templates::BiquadRamp> filterRamps;
         
         //
         //  FILTER ARRAYS for every RBJ filter type.
@@ -220,15 +281,15 @@ namespace Templates
         //  Only the array for the current filter type is ever
         //  populated with filters, so no worry about resources.
         //
-        OwnedArray<DSPFILTERS::Templates::RBJ::LowPass>   LPs;
-        OwnedArray<DSPFILTERS::Templates::RBJ::HighPass>  HPs;
-        OwnedArray<DSPFILTERS::Templates::RBJ::LowShelf>  LSs;
-        OwnedArray<DSPFILTERS::Templates::RBJ::HighShelf> HSs;
-        OwnedArray<DSPFILTERS::Templates::RBJ::BandPass1> BP1s;
-        OwnedArray<DSPFILTERS::Templates::RBJ::BandPass2> BP2s;
-        OwnedArray<DSPFILTERS::Templates::RBJ::BandStop>  BSs;
-        OwnedArray<DSPFILTERS::Templates::RBJ::BandShelf> SHs;
-        OwnedArray<DSPFILTERS::Templates::RBJ::AllPass>   APs;
+        FilterArray<DSPFILTERS::Templates::RBJ::LowPass>   LPs;
+        FilterArray<DSPFILTERS::Templates::RBJ::HighPass>  HPs;
+        FilterArray<DSPFILTERS::Templates::RBJ::LowShelf>  LSs;
+        FilterArray<DSPFILTERS::Templates::RBJ::HighShelf> HSs;
+        FilterArray<DSPFILTERS::Templates::RBJ::BandPass1> BP1s;
+        FilterArray<DSPFILTERS::Templates::RBJ::BandPass2> BP2s;
+        FilterArray<DSPFILTERS::Templates::RBJ::BandStop>  BSs;
+        FilterArray<DSPFILTERS::Templates::RBJ::BandShelf> SHs;
+        FilterArray<DSPFILTERS::Templates::RBJ::AllPass>   APs;
         
         //
         //  FILTER ALLOCATION
@@ -247,7 +308,7 @@ namespace Templates
                 {
                     if(LPs.size()!=Order)
                     {
-                        LPs.clear(true);
+                        LPs.clear();
                     }
                 }
                 
@@ -265,7 +326,7 @@ namespace Templates
                 {
                     if(HPs.size()!=Order)
                     {
-                        HPs.clear(true);
+                        HPs.clear();
                     }
                 }
                 
@@ -283,7 +344,7 @@ namespace Templates
                 {
                     if(LSs.size()!=Order)
                     {
-                        LSs.clear(true);
+                        LSs.clear();
                     }
                 }
                 
@@ -301,7 +362,7 @@ namespace Templates
                 {
                     if(HSs.size()!=Order)
                     {
-                        HSs.clear(true);
+                        HSs.clear();
                     }
                 }
                 
@@ -319,7 +380,7 @@ namespace Templates
                 {
                     if(BP1s.size()!=Order)
                     {
-                        BP1s.clear(true);
+                        BP1s.clear();
                     }
                 }
                 
@@ -335,7 +396,7 @@ namespace Templates
             {
                 if(!BP2s.isEmpty())
                 {
-                    if(BP2s.size()!=Order){BP2s.clear(true);
+                    if(BP2s.size()!=Order){BP2s.clear();
                     }
                 }
                 
@@ -353,7 +414,7 @@ namespace Templates
                 {
                     if(BSs.size()!=Order)
                     {
-                        BSs.clear(true);
+                        BSs.clear();
                     }
                 }
                 
@@ -371,7 +432,7 @@ namespace Templates
                 {
                     if(SHs.size()!=Order)
                     {
-                        SHs.clear(true);
+                        SHs.clear();
                     }
                 }
                 
@@ -389,7 +450,7 @@ namespace Templates
                 {
                     if(APs.size()!=Order)
                     {
-                        APs.clear(true);
+                        APs.clear();
                     }
                 }
                 
@@ -416,12 +477,21 @@ namespace Templates
         {
             if (coeffsUpdated==true)
             {
-                /* reset filter states */
-                filterState.clear(true);
-
-                for(int step=0;step<Order;++step)
+                //  Gliding keeps the states and ramps the coefficients,
+                //  but only if there already is something to glide from.
+                const bool glide=(glideSamples>0 and filterState.size()==(int)Order);
+                
+                if(glide==false)
                 {
-                    filterState.add(new DSPFILTERS::Templates::DEFAULT_STATE);
+                    /* reset filter states */
+                    filterState.clear();
+                    filterRamps.clear();
+                    
+                    for(unsigned int step=0;step<Order;++step)
+                    {
+                        filterState.add(new DSPFILTERS::Templates::DEFAULT_STATE);
+                        filterRamps.add(new DSPFILTERS::Templates::BiquadRamp);
+                    }
                 }
                 
                 
@@ -431,7 +501,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<LPs.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*LPs[filter]);}
                             LPs[filter]->setup(filterSampleRate,filterFrequency,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*LPs[filter],glideSamples);}
                         }
                     }
                 }
@@ -441,7 +513,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<HPs.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*HPs[filter]);}
                             HPs[filter]->setup(filterSampleRate,filterFrequency,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*HPs[filter],glideSamples);}
                         }
                     }
                 }
@@ -451,7 +525,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<LSs.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*LSs[filter]);}
                             LSs[filter]->setup(filterSampleRate,filterFrequency,filterGain,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*LSs[filter],glideSamples);}
                         }
                     }
                 }
@@ -461,7 +537,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<HSs.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*HSs[filter]);}
                             HSs[filter]->setup(filterSampleRate,filterFrequency,filterGain,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*HSs[filter],glideSamples);}
                         }
                     }
                 }
@@ -471,7 +549,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<BP1s.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*BP1s[filter]);}
                             BP1s[filter]->setup(filterSampleRate,filterFrequency,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*BP1s[filter],glideSamples);}
                         }
                     }
                 }
@@ -481,7 +561,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<BP2s.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*BP2s[filter]);}
                             BP2s[filter]->setup(filterSampleRate,filterFrequency,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*BP2s[filter],glideSamples);}
                         }
                     }
                 }
@@ -491,7 +573,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<BSs.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*BSs[filter]);}
                             BSs[filter]->setup(filterSampleRate,filterFrequency,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*BSs[filter],glideSamples);}
                         }
                     }
                 }
@@ -501,7 +585,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<SHs.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*SHs[filter]);}
                             SHs[filter]->setup(filterSampleRate,filterFrequency,filterGain,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*SHs[filter],glideSamples);}
                         }
                     }
                 }
@@ -511,7 +597,9 @@ namespace Templates
                     {
                         for(int filter=0;filter<APs.size();++filter)
                         {
+                            if(glide==true){filterRamps[filter]->begin(*APs[filter]);}
                             APs[filter]->setup(filterSampleRate,filterFrequency,filterWidth);
+                            if(glide==true){filterRamps[filter]->end(*APs[filter],glideSamples);}
                         }
                     }
                 }
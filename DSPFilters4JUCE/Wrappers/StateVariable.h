@@ -0,0 +1,407 @@
+//  *----------------------------------------------------------------------------*
+//
+//  DSPFilters optimized for JUCE
+//
+//  *----------------------------------------------------------------------------*
+//
+//  "A Collection of Useful C++ Classes for Digital Signal Processing"
+//
+//  Original DSPFilters library by Vinnie Falco
+//  https://github.com/vinniefalco/DSPFilters
+//  Copyright (c) 2009 by Vinnie Falco
+//
+//  Adapted for Linux by Bernd Porr
+//  https://github.com/berndporr/iir1
+//  Copyright (c) 2012 by Bernd Porr
+//
+//  Optimized for JUCE by Rob Clifton-Harvey
+//  https://github.com/rcliftonharvey/dspfilters4juce
+//  Copyright (c) 2017 by Rob Clifton-Harvey
+//
+//  *----------------------------------------------------------------------------*
+//  License: MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//  *----------------------------------------------------------------------------*
+
+#ifndef WRAPPER_STATEVARIABLE_H_INCLUDED
+#define WRAPPER_STATEVARIABLE_H_INCLUDED
+
+//
+//  STATE VARIABLE FILTERS     (zero delay feedback, after Andrew Simper)
+//  ======================
+//
+//    Supported DSPFILTERS::FilterTypes
+//    ---------------------------------
+//
+//      LOWPASS         Butterworth response, Order = filter order
+//      HIGHPASS        Butterworth response, Order = filter order
+//      LOWSHELF        RBJ response, Order = number of stacked sections
+//      HIGHSHELF       RBJ response, Order = number of stacked sections
+//      BANDPASS        RBJ response, Order = number of stacked sections
+//      BANDSTOP        RBJ response, Order = number of stacked sections
+//      BANDSHELF       RBJ response, Order = number of stacked sections
+//      ALLPASS         RBJ response, Order = number of stacked sections
+//
+//
+//  Sound the same as their Butterworth and RBJ counterparts, but keep
+//  behaving when you change their settings all the time. Great for
+//  sweeps and audio rate modulation.
+//
+//  LOWPASS and HIGHPASS can also give you the low, band and high pass
+//  outputs of the same filter all at once, see the bottom of the class.
+//
+//  Don't change this. Srsly tho.
+#define CUR_FILT_NAME DSPFILTERS::FilterNames::STATEVARIABLE
+//
+//  Default filter type and order if template arguments not given (feel free to change)
+#define CUR_DFLT_TYPE DSPFILTERS::FilterTypes::LOWPASS
+#define CUR_DFLT_ORDR 2
+// ------------------------------------------------------------------------------------- //
+
+template<DSPFILTERS::FilterTypes Type=CUR_DFLT_TYPE, unsigned int Order=CUR_DFLT_ORDR>
+class StateVariable : public SKELETON<CUR_FILT_NAME,Type,Order>, private WRAPPER<CUR_FILT_NAME,Type,Order>
+{
+public:
+    
+    StateVariable () {}
+    ~StateVariable () {}
+    
+    //
+    //  PARAMETER SETTER and GETTER methods
+    //
+    //  Setter methods allow you to change individual filter settings,
+    //  rather than always calling the humongous setup() one-liners.
+    //
+    //  Getter methods allow you to poll this filter's parameter values,
+    //  quite convenient if you want to poll them for your GUI from the
+    //  PluginEditor.cpp.
+    //
+    //  CAREFUL:
+    //    Not all filters behave alike. Where the Width on one may be a Q
+    //    value, the Width on another one may be another frequency. Inform.
+    //
+    //  Every wrapper will publish the methods fitting for its filter kind.
+    //
+    void setSampleRate  (double SR)     {SKELETON<CUR_FILT_NAME,Type,Order>::setSampleRate(SR);}
+    void setFrequency   (double Hz)     {SKELETON<CUR_FILT_NAME,Type,Order>::setFrequency(Hz);}
+    void setQ           (double Width)  {SKELETON<CUR_FILT_NAME,Type,Order>::setWidth(Width);}  /* using Width slot */
+    void setGain        (double dB)     {SKELETON<CUR_FILT_NAME,Type,Order>::setGain(dB);}
+    
+    double getSampleRate()  {return SKELETON<CUR_FILT_NAME,Type,Order>::getSampleRate();}
+    double getFrequency()   {return SKELETON<CUR_FILT_NAME,Type,Order>::getFrequency();}
+    double getQ()           {return SKELETON<CUR_FILT_NAME,Type,Order>::getWidth();}        /* using Width slot */
+    double getGain()        {return SKELETON<CUR_FILT_NAME,Type,Order>::getGain();}
+
+    void setControlRate (int samples)   {SKELETON<CUR_FILT_NAME,Type,Order>::setControlRate(samples);}
+    int  getControlRate ()              {return SKELETON<CUR_FILT_NAME,Type,Order>::getControlRate();}
+    
+    void   setMultirate (int factor)    {SKELETON<CUR_FILT_NAME,Type,Order>::setMultirate(factor);}
+    int    getMultirate ()              {return SKELETON<CUR_FILT_NAME,Type,Order>::getMultirate();}
+    double getLatency ()                {return SKELETON<CUR_FILT_NAME,Type,Order>::getLatency();}
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          SETUP ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to update the filter's settings.
+    //
+    //  Don't be afraid to call these often, the filters
+    //  will only reset if the values actually change.
+    //
+    //  Passing more parameters than *stream into process()
+    //  will call setup() before processing.
+    //
+    //  LOWPASS and HIGHPASS ignore Q and gain, they're
+    //  always Butterworth.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::StateVariable<LOWPASS,4> filter;     @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ PluginProcessor.cpp (anywhere)
+    //
+    //  -> creates LPF at 2 kHz at SR 44.1 kHz
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  quick one
+    void setup (double SR, double Hz)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::setup(SR,Hz,
+                                                  SKELETON<CUR_FILT_NAME,Type,Order>::filterWidth,
+                                                  SKELETON<CUR_FILT_NAME,Type,Order>::filterGain,
+                                                  SKELETON<CUR_FILT_NAME,Type,Order>::filterRipple,
+                                                  SKELETON<CUR_FILT_NAME,Type,Order>::filterRolloff);
+    }
+    
+    //  universal one
+    void setup (double SR, double Hz, double Width, double dB)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::setup(SR,Hz,
+                                                  Width,
+                                                  dB,
+                                                  SKELETON<CUR_FILT_NAME,Type,Order>::filterRipple,
+                                                  SKELETON<CUR_FILT_NAME,Type,Order>::filterRolloff);
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          PROCESSING ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to let an entire AudioSampleBuffer or ChannelSpan be filtered.
+    //  An AudioBuffer<double> (or double ChannelSpan) is filtered in double.
+    //
+    //  Call anywhere in processBlock() to apply.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::StateVariable<BANDSHELF,1> filter;   @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0,0.7,-3.0);           @ PluginProcessor.cpp (anywhere)
+    //     filter.process(&buffer);                         @ PluginProcessor.cpp (anywhere)
+    //     ---- or ----
+    //     filter.process(&buffer,44100.0,2000.0,0.7,-3.0); @ PluginProcessor.cpp (anywhere)
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  process only -- make sure the filter is set up correctly!
+    void process (ChannelSpan stream)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(stream);
+    }
+    
+    //  quick one
+    void process (ChannelSpan stream, double SR, double Hz)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(stream,SR,Hz,
+                                                    SKELETON<CUR_FILT_NAME,Type,Order>::filterWidth,
+                                                    SKELETON<CUR_FILT_NAME,Type,Order>::filterGain,
+                                                    SKELETON<CUR_FILT_NAME,Type,Order>::filterRipple,
+                                                    SKELETON<CUR_FILT_NAME,Type,Order>::filterRolloff);
+    }
+    
+    //  universal one
+    void process (ChannelSpan stream, double SR, double Hz, double Width, double dB)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(stream,SR,Hz,
+                                                    Width,
+                                                    dB,
+                                                    SKELETON<CUR_FILT_NAME,Type,Order>::filterRipple,
+                                                    SKELETON<CUR_FILT_NAME,Type,Order>::filterRolloff);
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          INTERLEAVED ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to filter interleaved audio in place, like L R L R...
+    //  straight from a sound card, a host or an audio file, without
+    //  splitting it into an AudioSampleBuffer first.
+    //
+    //  State Variable filters aren't made of biquads, so these go through
+    //  the regular channel filters, a few frames at a time.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::StateVariable<LOWPASS,4> filter;     @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ PluginProcessor.cpp (anywhere)
+    //     filter.process(frames,numFrames,2);              @ anywhere
+    //
+    //  -> frames is a float or double array with numFrames x 2 samples, L R L R...
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  interleaved one
+    void process (float* interleaved, int numFrames, int numChannels)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(interleaved,numFrames,numChannels);
+    }
+    
+    //  interleaved one, in double
+    void process (double* interleaved, int numFrames, int numChannels)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(interleaved,numFrames,numChannels);
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          OUT OF PLACE ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to read one buffer and write the filtered signal into another,
+    //  so the dry signal stays as it was, without copying it first.
+    //
+    //  The ranged ones filter numChannels x numSamples from the given start
+    //  channels and samples on, input and output can be of different sizes.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::StateVariable<LOWPASS,4> filter;     @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ PluginProcessor.cpp (anywhere)
+    //     filter.process(buffer,wetBuffer);                @ PluginProcessor.cpp (anywhere)
+    //
+    //  -> wetBuffer has to have as many channels and samples as buffer
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  out of place one
+    void process (ChannelSpan input, ChannelSpan output)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output);
+    }
+    
+    //  ranged one
+    void process (ChannelSpan input, int inputChannel, int inputSample, ChannelSpan output, int outputChannel, int outputSample, int numChannels, int numSamples)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,inputChannel,inputSample,output,outputChannel,outputSample,numChannels,numSamples);
+    }
+    
+    //  raw pointer one
+    void process (const float* const* input, float* const* output, int numChannels, int numSamples, int inputSample=0, int outputSample=0)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output,numChannels,numSamples,inputSample,outputSample);
+    }
+    
+    //  raw pointer one, in double
+    void process (const double* const* input, double* const* output, int numChannels, int numSamples, int inputSample=0, int outputSample=0)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output,numChannels,numSamples,inputSample,outputSample);
+    }
+    
+#if DSPFILTERS_JUCE
+    //  out of place one, with AudioSampleBuffers
+    void process (const AudioSampleBuffer& input, AudioSampleBuffer& output)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output);
+    }
+    
+    //  ranged one, with AudioSampleBuffers
+    void process (const AudioSampleBuffer& input, int inputChannel, int inputSample, AudioSampleBuffer& output, int outputChannel, int outputSample, int numChannels, int numSamples)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,inputChannel,inputSample,output,outputChannel,outputSample,numChannels,numSamples);
+    }
+    
+    //  out of place one, with AudioBuffer<double>s
+    void process (const AudioBuffer<double>& input, AudioBuffer<double>& output)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,output);
+    }
+    
+    //  ranged one, with AudioBuffer<double>s
+    void process (const AudioBuffer<double>& input, int inputChannel, int inputSample, AudioBuffer<double>& output, int outputChannel, int outputSample, int numChannels, int numSamples)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(input,inputChannel,inputSample,output,outputChannel,outputSample,numChannels,numSamples);
+    }
+#endif
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          MODULATION ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to sweep the filter with one value per sample, for
+    //  example from an LFO or an envelope follower.
+    //
+    //  State Variable filters don't need to glide, so you can set
+    //  the control rate all the way down to 1 and have the filter
+    //  follow your modulation sample by sample.
+    //
+    //  Pass nullptr for parameters you don't want to modulate.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::StateVariable<LOWPASS,4> filter;     @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ PluginProcessor.cpp (anywhere)
+    //     filter.setControlRate(1);                        @ PluginProcessor.cpp (anywhere)
+    //     filter.process(&buffer,cutoffs);                 @ PluginProcessor.cpp (anywhere)
+    //
+    //  -> cutoffs is a float array with one frequency in Hz per sample
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  modulated one
+    void process (ChannelSpan stream, const float* cutoffModulation, const float* qModulation=nullptr, const float* gainModulation=nullptr)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::process(stream,cutoffModulation,qModulation,gainModulation);
+    }
+    
+    // --------------------------------------------------------------------------------- //
+    //
+    //          MULTI OUTPUT ROUTINES
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  Use these to get the low pass, band pass and high pass outputs
+    //  of the same filter at the same time. Only for LOWPASS/HIGHPASS.
+    //
+    //  The input stream is left untouched. The output buffers need the
+    //  same number of channels and samples as the input stream, pass
+    //  nullptr for any output you don't need.
+    //
+    //  For Order 1 and 2 this is one single filter run for all three.
+    //  With Order 2, low + band + high add back up to the input.
+    //
+    // --------------------------------------------------------------------------------- //
+    //
+    //  EXAMPLE:
+    //
+    //     DSPFILTERS::StateVariable<LOWPASS,2> filter;     @ PluginProcessor.h file !!!
+    //
+    //     filter.setup(44100.0,2000.0);                    @ PluginProcessor.cpp (anywhere)
+    //     filter.process(&buffer,&low,&band,&high);        @ PluginProcessor.cpp (anywhere)
+    //
+    // --------------------------------------------------------------------------------- //
+    
+    //  multi output one
+    void process (ChannelSpan stream, ChannelSpan low, ChannelSpan band, ChannelSpan high)
+    {
+        SKELETON<CUR_FILT_NAME,Type,Order>::processMultiOutput(stream,low,band,high);
+    }
+    
+};
+
+
+// Leave these here to avoid compiler warnings
+#undef CUR_FILT_NAME
+#undef CUR_DFLT_TYPE
+#undef CUR_DFLT_ORDR
+
+#endif // WRAPPER_STATEVARIABLE_H_INCLUDED
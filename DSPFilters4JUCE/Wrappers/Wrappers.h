@@ -56,7 +56,7 @@
 namespace Wrappers
 {
     //
-    //  The Skeleton class provides the structure for the AudioSampleBuffer based filter wrappers.
+    //  The Skeleton class provides the structure for the multichannel buffer based filter wrappers.
     //
     //  Forward-declaring this so it can be 'friend' with Wrapper class.
     //  Scroll down past Wrapper class for full Skeleton declaration.
@@ -84,7 +84,7 @@ namespace Wrappers
     //  Everything in here is still per-sample.
     //
     //  The Skeleton class further down turns these 'abstract' single
-    //  channel filters into autonomous AudioSampleBuffer processors.
+    //  channel filters into autonomous multichannel buffer processors.
     //
     template <DSPFILTERS::FilterNames Name, DSPFILTERS::FilterTypes Type, int Order>
     class Wrapper
@@ -201,6 +201,15 @@ namespace Wrappers
             else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {processed=rbjohn.BS.filter(input);}
             else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {processed=rbjohn.SH.filter(input);}
             else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::ALLPASS))   {processed=rbjohn.AP.filter(input);}
+            /* State Variable Filters */
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {processed=svfilt.LP.filter(input);}
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {processed=svfilt.HP.filter(input);}
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::LOWSHELF)) {processed=svfilt.LS.filter(input);}
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)){processed=svfilt.HS.filter(input);}
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {processed=svfilt.BP.filter(input);}
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {processed=svfilt.BS.filter(input);}
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)){processed=svfilt.SH.filter(input);}
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::ALLPASS))  {processed=svfilt.AP.filter(input);}
 
             return processed;
         }
@@ -212,8 +221,220 @@ namespace Wrappers
             return processSample(input);
         }
         
+        //
+        //  MULTI OUTPUT PER SAMPLE processing, only for the State Variable filters.
+        //
+        //  Gives you the low pass, band pass and high pass outputs of the same
+        //  filter in one go. Only the LOWPASS and HIGHPASS types have this, as
+        //  they're the ones whose sections all share the same cutoff.
+        //
+        void processSample (double input, double& low, double& band, double& high)
+        {
+            updateFilters();
+            
+            jassert(filterSampleRate>0.0);
+            jassert(filterFrequency>0.0);
+            
+            if      ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {svfilt.LP.filter(input,low,band,high);}
+            else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {svfilt.HP.filter(input,low,band,high);}
+            else
+            {
+                jassertfalse;
+                low=band=high=input;
+            }
+        }
+        
+        //
+        //  MODULATED SETUP, called from Skeleton::process() once per control period.
+        //
+        //  Works like setup(), except the filters are NOT reset when the values
+        //  change. Their coefficients glide to the new settings over the next
+        //  numSamples calls of processSample(input) instead.
+        //
+        //  The very first design can't glide from anywhere, so that one is
+        //  a regular setup with reset.
+        //
+        void modulate (double SR, double Hz, double Width, double dB, double Ripple, double Rolloff, int numSamples)
+        {
+            setup(SR,Hz,Width,dB,Ripple,Rolloff);
+            
+            if(filtersDesigned==true)
+            {
+                glideLength=numSamples;
+            }
+            
+            updateFilters();
+            
+            glideLength=0;
+        }
+        
+        //
+        //  BLOCK PROCESSING of a SINGLE FILTER instance.
+        //
+        //  Same result as calling processSample(input) on every sample, but
+        //  the pole filters hand the whole block to their cascade, which can
+        //  then run it through the block state space kernel (BlockKernel.h)
+        //  and put the SIMD lanes to use on a single channel.
+        //
+        //  The RBJ and State Variable filters just go sample by sample.
+        //
+        //  Takes floats or doubles, the cascades filter both in double anyway.
+        //
+        template <typename Sample>
+        void processBlock (Sample* data, int numSamples)
+        {
+            processBlock(data,data,numSamples);
+        }
+        
+        //  Same, but reads input and writes output, which may also be the same.
+        template <typename Sample>
+        void processBlock (const Sample* input, Sample* output, int numSamples)
+        {
+            updateFilters();
+            
+            jassert(filterSampleRate>0.0);
+            jassert(filterFrequency>0.0);
+            
+            /* Bessel Filters */
+            if      ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {bessel.LP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {bessel.HP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::LOWSHELF)) {bessel.LS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {bessel.BP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {bessel.BS.filterBlock(numSamples,input,output);}
+            /* Butterworth Filters */
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {bworth.LP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {bworth.HP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {bworth.LS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {bworth.HS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {bworth.BP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {bworth.BS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {bworth.SH.filterBlock(numSamples,input,output);}
+            /* ChebyshevI Filters */
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {cshev1.LP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {cshev1.HP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {cshev1.LS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {cshev1.HS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {cshev1.BP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {cshev1.BS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {cshev1.SH.filterBlock(numSamples,input,output);}
+            /* ChebyshevII Filters */
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {cshev2.LP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {cshev2.HP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {cshev2.LS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {cshev2.HS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {cshev2.BP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {cshev2.BS.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {cshev2.SH.filterBlock(numSamples,input,output);}
+            /* Elliptic Filters */
+            else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {ellipt.LP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {ellipt.HP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {ellipt.BP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {ellipt.BS.filterBlock(numSamples,input,output);}
+            /* Legendre Filters */
+            else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {legend.LP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {legend.HP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {legend.BP.filterBlock(numSamples,input,output);}
+            else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {legend.BS.filterBlock(numSamples,input,output);}
+            else
+            {
+                for(int sample=0;sample<numSamples;++sample)
+                {
+                    output[sample]=(Sample)processSample(input[sample]);
+                }
+            }
+        }
+        
+        //
+        //  EXPORTS the current coefficients of this filter as plain biquads.
+        //
+        //  The offline engines in the Skeleton class (zero phase and such)
+        //  run their own states over whole files, they just need to know
+        //  the coefficients. Returns the number of biquads written, or 0 if
+        //  the filter isn't made of biquads, like the State Variable ones.
+        //
+        int getStages (DSPFILTERS::Templates::Biquad* stages, int maxStages)
+        {
+            updateFilters();
+            
+            jassert(filterSampleRate>0.0);
+            jassert(filterFrequency>0.0);
+            
+            int numStages=0;
+            
+            /* Bessel Filters */
+            if      ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {numStages=copyStages(bessel.LP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {numStages=copyStages(bessel.HP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::LOWSHELF)) {numStages=copyStages(bessel.LS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {numStages=copyStages(bessel.BP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {numStages=copyStages(bessel.BS,stages,maxStages);}
+            /* Butterworth Filters */
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {numStages=copyStages(bworth.LP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {numStages=copyStages(bworth.HP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {numStages=copyStages(bworth.LS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {numStages=copyStages(bworth.HS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {numStages=copyStages(bworth.BP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {numStages=copyStages(bworth.BS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {numStages=copyStages(bworth.SH,stages,maxStages);}
+            /* ChebyshevI Filters */
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {numStages=copyStages(cshev1.LP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {numStages=copyStages(cshev1.HP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {numStages=copyStages(cshev1.LS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {numStages=copyStages(cshev1.HS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {numStages=copyStages(cshev1.BP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {numStages=copyStages(cshev1.BS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {numStages=copyStages(cshev1.SH,stages,maxStages);}
+            /* ChebyshevII Filters */
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {numStages=copyStages(cshev2.LP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {numStages=copyStages(cshev2.HP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {numStages=copyStages(cshev2.LS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {numStages=copyStages(cshev2.HS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {numStages=copyStages(cshev2.BP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {numStages=copyStages(cshev2.BS,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {numStages=copyStages(cshev2.SH,stages,maxStages);}
+            /* Elliptic Filters */
+            else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {numStages=copyStages(ellipt.LP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {numStages=copyStages(ellipt.HP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {numStages=copyStages(ellipt.BP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {numStages=copyStages(ellipt.BS,stages,maxStages);}
+            /* Legendre Filters */
+            else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {numStages=copyStages(legend.LP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {numStages=copyStages(legend.HP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {numStages=copyStages(legend.BP,stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {numStages=copyStages(legend.BS,stages,maxStages);}
+            /* Robert Bristow-Johnson Filters */
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {numStages=rbjohn.LP.getStages(stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {numStages=rbjohn.HP.getStages(stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {numStages=rbjohn.LS.getStages(stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {numStages=rbjohn.HS.getStages(stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {numStages=rbjohn.BP1.getStages(stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDPASS2)) {numStages=rbjohn.BP2.getStages(stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {numStages=rbjohn.BS.getStages(stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {numStages=rbjohn.SH.getStages(stages,maxStages);}
+            else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::ALLPASS))   {numStages=rbjohn.AP.getStages(stages,maxStages);}
+            
+            return numStages;
+        }
+        
     private:
         
+        //  Helper for getStages(), copies the stages of any cascade. The engines
+        //  that take them keep the coefficients fixed, they can't glide along.
+        template <class CascadeType>
+        int copyStages (CascadeType& cascade, DSPFILTERS::Templates::Biquad* stages, int maxStages)
+        {
+            jassert(cascade.getNumStages()<=maxStages);
+            jassert(!cascade.isGliding());
+            
+            const int numStages=jmin(cascade.getNumStages(),maxStages);
+            
+            for(int stage=0;stage<numStages;++stage)
+            {
+                stages[stage]=cascade[stage];
+            }
+            
+            return numStages;
+        }
+        
         //
         //  ALL TEH FILTERZ
         //
@@ -303,8 +524,38 @@ namespace Wrappers
             DSPFILTERS::Templates::RBJArray<DSPFILTERS::FilterTypes::ALLPASS,Order>   AP;
         } rbjohn;
         
+        //
+        //  The State Variable filters come in two flavours. LOWPASS and HIGHPASS
+        //  are Butterworth responses, their Order is the filter order like with
+        //  all the other Butterworths. The rest are the RBJ responses, and just
+        //  like with the RBJArray their Order is the number of stacked sections.
+        //
+        //  See Templates/StateVariable.h for the details.
+        //
+        struct StateVariableFilters
+        {
+            DSPFILTERS::Templates::StateVariable::LowPass<Order>   LP;
+            DSPFILTERS::Templates::StateVariable::HighPass<Order>  HP;
+            DSPFILTERS::Templates::StateVariable::LowShelf<Order>  LS;
+            DSPFILTERS::Templates::StateVariable::HighShelf<Order> HS;
+            DSPFILTERS::Templates::StateVariable::BandPass<Order>  BP;
+            DSPFILTERS::Templates::StateVariable::BandStop<Order>  BS;
+            DSPFILTERS::Templates::StateVariable::BandShelf<Order> SH;
+            DSPFILTERS::Templates::StateVariable::AllPass<Order>   AP;
+        } svfilt;
+        
         bool coeffsUpdated=false;
         
+        //
+        //  MODULATION
+        //
+        //  While glideLength is larger than 0, updateFilters() will not reset
+        //  the filters, but let their coefficients glide to the new settings.
+        //  There's nothing to glide from before the first design, of course.
+        //
+        int glideLength=0;
+        bool filtersDesigned=false;
+        
         //
         //  FILTER SETTINGS
         //
@@ -336,68 +587,100 @@ namespace Wrappers
                 //  REMEMBER to .reset() the filters before updating their coefficients
                 //  Doing no resets can lead to SUPER loud peaks... so just do them.
                 //
+                //  beginUpdate() does that for you. The only time it doesn't reset is
+                //  when the filter is being modulated, then the coefficients glide to
+                //  the new settings instead. That keeps the peaks away just as well.
+                //
 
                 /* Bessel Filters */
-                if      ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {bessel.LP.reset();bessel.LP.setup(Order,filterSampleRate,filterFrequency);}
-                else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {bessel.HP.reset();bessel.HP.setup(Order,filterSampleRate,filterFrequency);}
-                else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::LOWSHELF)) {bessel.LS.reset();bessel.LS.setup(Order,filterSampleRate,filterFrequency,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {bessel.BP.reset();bessel.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth);}
-                else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {bessel.BS.reset();bessel.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth);}
+                if      ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {beginUpdate(bessel.LP);bessel.LP.setup(Order,filterSampleRate,filterFrequency);endUpdate(bessel.LP);}
+                else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {beginUpdate(bessel.HP);bessel.HP.setup(Order,filterSampleRate,filterFrequency);endUpdate(bessel.HP);}
+                else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::LOWSHELF)) {beginUpdate(bessel.LS);bessel.LS.setup(Order,filterSampleRate,filterFrequency,filterGain);endUpdate(bessel.LS);}
+                else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {beginUpdate(bessel.BP);bessel.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(bessel.BP);}
+                else if ((Name==DSPFILTERS::FilterNames::BESSEL) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {beginUpdate(bessel.BS);bessel.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(bessel.BS);}
                 /* Butterworth Filters */
-                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {bworth.LP.reset();bworth.LP.setup(Order,filterSampleRate,filterFrequency);}
-                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {bworth.HP.reset();bworth.HP.setup(Order,filterSampleRate,filterFrequency);}
-                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {bworth.LS.reset();bworth.LS.setup(Order,filterSampleRate,filterFrequency,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {bworth.HS.reset();bworth.HS.setup(Order,filterSampleRate,filterFrequency,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {bworth.BP.reset();bworth.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth);}
-                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {bworth.BS.reset();bworth.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth);}
-                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {bworth.SH.reset();bworth.SH.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterGain);}
+                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {beginUpdate(bworth.LP);bworth.LP.setup(Order,filterSampleRate,filterFrequency);endUpdate(bworth.LP);}
+                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {beginUpdate(bworth.HP);bworth.HP.setup(Order,filterSampleRate,filterFrequency);endUpdate(bworth.HP);}
+                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {beginUpdate(bworth.LS);bworth.LS.setup(Order,filterSampleRate,filterFrequency,filterGain);endUpdate(bworth.LS);}
+                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {beginUpdate(bworth.HS);bworth.HS.setup(Order,filterSampleRate,filterFrequency,filterGain);endUpdate(bworth.HS);}
+                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {beginUpdate(bworth.BP);bworth.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(bworth.BP);}
+                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {beginUpdate(bworth.BS);bworth.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(bworth.BS);}
+                else if ((Name==DSPFILTERS::FilterNames::BUTTERWORTH) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {beginUpdate(bworth.SH);bworth.SH.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterGain);endUpdate(bworth.SH);}
                 /* ChebyshevI Filters */
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {cshev1.LP.reset();cshev1.LP.setup(Order,filterSampleRate,filterFrequency,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {cshev1.HP.reset();cshev1.HP.setup(Order,filterSampleRate,filterFrequency,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {cshev1.LS.reset();cshev1.LS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {cshev1.HS.reset();cshev1.HS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {cshev1.BP.reset();cshev1.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {cshev1.BS.reset();cshev1.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {cshev1.SH.reset();cshev1.SH.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterGain,filterRipple);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {beginUpdate(cshev1.LP);cshev1.LP.setup(Order,filterSampleRate,filterFrequency,filterRipple);endUpdate(cshev1.LP);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {beginUpdate(cshev1.HP);cshev1.HP.setup(Order,filterSampleRate,filterFrequency,filterRipple);endUpdate(cshev1.HP);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {beginUpdate(cshev1.LS);cshev1.LS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterRipple);endUpdate(cshev1.LS);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {beginUpdate(cshev1.HS);cshev1.HS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterRipple);endUpdate(cshev1.HS);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {beginUpdate(cshev1.BP);cshev1.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple);endUpdate(cshev1.BP);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {beginUpdate(cshev1.BS);cshev1.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple);endUpdate(cshev1.BS);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVI) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {beginUpdate(cshev1.SH);cshev1.SH.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterGain,filterRipple);endUpdate(cshev1.SH);}
                 /* ChebyshevII Filters */
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {cshev2.LP.reset();cshev2.LP.setup(Order,filterSampleRate,filterFrequency,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {cshev2.HP.reset();cshev2.HP.setup(Order,filterSampleRate,filterFrequency,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {cshev2.LS.reset();cshev2.LS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {cshev2.HS.reset();cshev2.HS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {cshev2.BP.reset();cshev2.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {cshev2.BS.reset();cshev2.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple);}
-                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {cshev2.SH.reset();cshev2.SH.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterGain,filterRipple);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::LOWPASS))   {beginUpdate(cshev2.LP);cshev2.LP.setup(Order,filterSampleRate,filterFrequency,filterRipple);endUpdate(cshev2.LP);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::HIGHPASS))  {beginUpdate(cshev2.HP);cshev2.HP.setup(Order,filterSampleRate,filterFrequency,filterRipple);endUpdate(cshev2.HP);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::LOWSHELF))  {beginUpdate(cshev2.LS);cshev2.LS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterRipple);endUpdate(cshev2.LS);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)) {beginUpdate(cshev2.HS);cshev2.HS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterRipple);endUpdate(cshev2.HS);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDPASS))  {beginUpdate(cshev2.BP);cshev2.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple);endUpdate(cshev2.BP);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDSTOP))  {beginUpdate(cshev2.BS);cshev2.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple);endUpdate(cshev2.BS);}
+                else if ((Name==DSPFILTERS::FilterNames::CHEBYSHEVII) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)) {beginUpdate(cshev2.SH);cshev2.SH.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterGain,filterRipple);endUpdate(cshev2.SH);}
                 /* Elliptic Filters */
-                else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {ellipt.LP.reset();ellipt.LP.setup(Order,filterSampleRate,filterFrequency,filterRipple,filterRolloff);}
-                else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {ellipt.HP.reset();ellipt.HP.setup(Order,filterSampleRate,filterFrequency,filterRipple,filterRolloff);}
-                else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {ellipt.BP.reset();ellipt.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple,filterRolloff);}
-                else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {ellipt.BS.reset();ellipt.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple,filterRolloff);}
+                else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {beginUpdate(ellipt.LP);ellipt.LP.setup(Order,filterSampleRate,filterFrequency,filterRipple,filterRolloff);endUpdate(ellipt.LP);}
+                else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {beginUpdate(ellipt.HP);ellipt.HP.setup(Order,filterSampleRate,filterFrequency,filterRipple,filterRolloff);endUpdate(ellipt.HP);}
+                else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {beginUpdate(ellipt.BP);ellipt.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple,filterRolloff);endUpdate(ellipt.BP);}
+                else if ((Name==DSPFILTERS::FilterNames::ELLIPTIC) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {beginUpdate(ellipt.BS);ellipt.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth,filterRipple,filterRolloff);endUpdate(ellipt.BS);}
                 /* Legendre Filters */
-                else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {legend.LP.reset();legend.LP.setup(Order,filterSampleRate,filterFrequency);}
-                else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {legend.HP.reset();legend.HP.setup(Order,filterSampleRate,filterFrequency);}
-                else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {legend.BP.reset();legend.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth);}
-                else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {legend.BS.reset();legend.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth);}
+                else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {beginUpdate(legend.LP);legend.LP.setup(Order,filterSampleRate,filterFrequency);endUpdate(legend.LP);}
+                else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {beginUpdate(legend.HP);legend.HP.setup(Order,filterSampleRate,filterFrequency);endUpdate(legend.HP);}
+                else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {beginUpdate(legend.BP);legend.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(legend.BP);}
+                else if ((Name==DSPFILTERS::FilterNames::LEGENDRE) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {beginUpdate(legend.BS);legend.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(legend.BS);}
                 /* Robert Bristow-Johnson Filters */
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {rbjohn.LP.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);} /* these handle reset() on their own */
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {rbjohn.HP.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::LOWSHELF)) {rbjohn.LS.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)){rbjohn.HS.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {rbjohn.BP1.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDPASS2)){rbjohn.BP2.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {rbjohn.BS.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)){rbjohn.SH.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);}
-                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::ALLPASS))  {rbjohn.AP.setup(filterSampleRate,filterFrequency,filterWidth,filterGain);}
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {rbjohn.LP.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);} /* these handle reset() on their own */
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {rbjohn.HP.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);}
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::LOWSHELF)) {rbjohn.LS.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);}
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)){rbjohn.HS.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);}
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {rbjohn.BP1.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);}
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDPASS2)){rbjohn.BP2.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);}
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {rbjohn.BS.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);}
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)){rbjohn.SH.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);}
+                else if ((Name==DSPFILTERS::FilterNames::COOKBOOK) and (Type==DSPFILTERS::FilterTypes::ALLPASS))  {rbjohn.AP.setup(filterSampleRate,filterFrequency,filterWidth,filterGain,glideLength);}
+                /* State Variable Filters */
+                else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::LOWPASS))  {beginUpdate(svfilt.LP);svfilt.LP.setup(Order,filterSampleRate,filterFrequency);endUpdate(svfilt.LP);}
+                else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::HIGHPASS)) {beginUpdate(svfilt.HP);svfilt.HP.setup(Order,filterSampleRate,filterFrequency);endUpdate(svfilt.HP);}
+                else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::LOWSHELF)) {beginUpdate(svfilt.LS);svfilt.LS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterWidth);endUpdate(svfilt.LS);}
+                else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::HIGHSHELF)){beginUpdate(svfilt.HS);svfilt.HS.setup(Order,filterSampleRate,filterFrequency,filterGain,filterWidth);endUpdate(svfilt.HS);}
+                else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::BANDPASS)) {beginUpdate(svfilt.BP);svfilt.BP.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(svfilt.BP);}
+                else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::BANDSTOP)) {beginUpdate(svfilt.BS);svfilt.BS.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(svfilt.BS);}
+                else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::BANDSHELF)){beginUpdate(svfilt.SH);svfilt.SH.setup(Order,filterSampleRate,filterFrequency,filterGain,filterWidth);endUpdate(svfilt.SH);}
+                else if ((Name==DSPFILTERS::FilterNames::STATEVARIABLE) and (Type==DSPFILTERS::FilterTypes::ALLPASS))  {beginUpdate(svfilt.AP);svfilt.AP.setup(Order,filterSampleRate,filterFrequency,filterWidth);endUpdate(svfilt.AP);}
 
                 //  Don't forget to end the refresh once everything's set.
                 //  Feel free to comment out if you like wasting shameful
                 //  amounts of CPU... wanna guess how I found out? *sigh*
                 coeffsUpdated=false;
+                
+                filtersDesigned=true;
             }
         }
+        
+        //
+        //  Helpers for updateFilters(), either reset the filter or prepare
+        //  a coefficient glide, depending on whether we're modulating.
+        //
+        template <class FilterType>
+        void beginUpdate (FilterType& filter)
+        {
+            if(glideLength>0)   {filter.beginGlide();}
+            else                {filter.reset();}
+        }
+        
+        template <class FilterType>
+        void endUpdate (FilterType& filter)
+        {
+            if(glideLength>0)   {filter.endGlide(glideLength);}
+        }
     }; // end class Wrapper
     
 // ---------------------------------------------------------------------------------------------------------------------------------------------------- //
-// ------------------------------- AUDIOSAMPLEBUFFER BASED FILTERS ------------------------------------------------------------------------------------ //
+// ------------------------------- MULTICHANNEL BUFFER FILTERS --------------------------------------------------------------------------------------- //
 // ---------------------------------------------------------------------------------------------------------------------------------------------------- //
     
     //
@@ -406,8 +689,13 @@ namespace Wrappers
     //  This provides the structure for the filters you're going to use in your JUCE code.
     //
     //  It automatically instantiates and maintains the settings for as many filters as are
-    //  required to process all the samples in all the channels of an AudioSampleBuffer that
-    //  you send through its process() method.
+    //  required to process all the samples in all the channels of a ChannelSpan (or with
+    //  JUCE, an AudioSampleBuffer or AudioBuffer<double>) that you send through its
+    //  process() method.
+    //
+    //  Nothing in here needs JUCE. Any buffer type goes, as long as there's a float
+    //  or double pointer for each of its channels, see ChannelSpan.h. Doubles are
+    //  filtered as doubles, they never get rounded to float on the way.
     //
     template <DSPFILTERS::FilterNames Name, DSPFILTERS::FilterTypes Type, int Order>
     class Skeleton
@@ -439,13 +727,93 @@ namespace Wrappers
         double getRipple()      {return filterRipple;}
         double getRolloff()     {return filterRolloff;}
         
+        //
+        //  CONTROL RATE for the modulated process() method.
+        //
+        //  The filters are redesigned once every this many samples, and
+        //  the coefficients glide from one design to the next in between.
+        //  Lower means more accurate modulation, higher means less CPU.
+        //
+        void setControlRate (int samples) {jassert(samples>0);filterControlRate=jmax(1,samples);}
+        int  getControlRate ()            {return filterControlRate;}
+        
+        //
+        //  MULTIRATE processing for filters way down low, like sub bass or LFE.
+        //
+        //  With a factor of 2, 4 or 8 the regular process() decimates the audio
+        //  by that factor, runs the filter at the lower sample rate and then
+        //  interpolates back up. Saves CPU, and the filter's poles don't have
+        //  to squeeze up against z=1 so tightly, which keeps them accurate.
+        //
+        //  Everything the filter does has to happen below 0.4 x SR / factor.
+        //  High pass, band stop, low shelf, band shelf and all pass leave the
+        //  highs alone and only resample the part they change. HIGHSHELF does
+        //  change the highs and can't be run multirate. A factor of 1 is off.
+        //
+        //  This delays the output, ask getLatency() by how much.
+        //
+        //  Only the regular process() runs multirate. The modulated and the
+        //  multi output ones always run at the full rate, without that delay,
+        //  so switch multirate off before using them.
+        //
+        void setMultirate (int factor)
+        {
+            jassert(factor==1 or factor==2 or factor==4 or factor==8);
+            jassert(factor==1 or Type!=DSPFILTERS::FilterTypes::HIGHSHELF);
+            
+            if(Type==DSPFILTERS::FilterTypes::HIGHSHELF) {factor=1;}
+            
+            if(factor!=filterMultirate)
+            {
+                filterMultirate=factor;
+                
+                //  Designing the halfbands takes a while, so only once per factor
+                DSPFILTERS::Templates::Halfband::Multirate<> multirate;
+                multirate.setup(filterMultirate,isBandLimited(),multirateAttenuation,multirateTransition);
+                multirateLatency=multirate.getLatency();
+            }
+        }
+        
+        int getMultirate () {return filterMultirate;}
+        
+        //  Delay caused by multirate processing, in samples. Cheap enough to ask every block.
+        double getLatency () {return multirateLatency;}
+        
+        //
+        //  PARALLEL FORM for high order filters, 8th order and up.
+        //
+        //  A regular filter is a chain of biquads, each one waiting for the one
+        //  before it. Switched on, process() splits the filter into a sum of
+        //  biquads that all work on the input at the same time instead, which
+        //  is quicker on every CPU made this century. Same sound, down to
+        //  rounding. Doesn't work with modulation or multirate.
+        //
+        //  Very steep filters very far down can't be split accurately. Those
+        //  quietly stay chained, so it's always safe to switch this on.
+        //  The State Variable filters aren't made of biquads, no effect there.
+        //
+        void setParallelForm (bool parallel) {filterParallelForm=parallel;}
+        bool getParallelForm ()              {return filterParallelForm;}
+        
         //
         //  FILTER ARRAY that dynamically instantiates new or deletes old filters.
         //
         //  Holds one filter per channel to process. Its content is
         //  handled in prepareFilters() below.
         //
-        OwnedArray<DSPFILTERS::Wrappers::Wrapper<Name,Type,Order>> filterArray;
+        FilterArray<DSPFILTERS::Wrappers::Wrapper<Name,Type,Order>> filterArray;
+        
+        //
+        //  MULTIRATE ARRAY with one resampler per channel, only
+        //  populated while multirate processing is switched on.
+        //
+        FilterArray<DSPFILTERS::Templates::Halfband::Multirate<>> multirateArray;
+        
+        //
+        //  PARALLEL FORM ARRAY with one converted filter per
+        //  channel, only populated while the parallel form is on.
+        //
+        FilterArray<DSPFILTERS::Templates::ParallelForm::Stages<Order>> parallelArray;
         
         
         //
@@ -463,6 +831,27 @@ namespace Wrappers
         double filterRipple=0.0;        // in dB
         double filterRolloff=0.0;       // in dB
         
+        int filterControlRate=32;       // in samples
+        int filterMultirate=1;          // decimation factor
+        bool filterParallelForm=false;  // sum instead of chain
+        
+        //
+        //  MULTIRATE halfband settings. The filtered content sits far below
+        //  the low rate's Nyquist anyway, so a wide transition does the job.
+        //
+        double multirateAttenuation=100.0;  // in dB
+        double multirateTransition=0.05;    // relative to 2x low rate
+        double multirateLatency=0.0;        // of filterMultirate, in samples
+        
+        //  Low pass and band pass don't let anything through up high,
+        //  so their output can be resampled as a whole.
+        bool isBandLimited ()
+        {
+            return (Type==DSPFILTERS::FilterTypes::LOWPASS or
+                    Type==DSPFILTERS::FilterTypes::BANDPASS or
+                    Type==DSPFILTERS::FilterTypes::BANDPASS2);
+        }
+        
         //
         //  FILTER ALLOCATION
         //
@@ -479,7 +868,7 @@ namespace Wrappers
             {
                 if(filterArray.size()!=numChannels)
                 {
-                    filterArray.clear(true);
+                    filterArray.clear();
                 }
             }
             
@@ -491,6 +880,44 @@ namespace Wrappers
                     filterArray.add(new DSPFILTERS::Wrappers::Wrapper<Name,Type,Order>);
                 }
             }
+            
+            /* multirate resamplers follow the channels and the factor */
+            if(filterMultirate>1)
+            {
+                if(multirateArray.size()!=numChannels or multirateArray[0]->getFactor()!=filterMultirate)
+                {
+                    multirateArray.clear();
+                    
+                    for(int channel=0;channel<numChannels;++channel)
+                    {
+                        DSPFILTERS::Templates::Halfband::Multirate<>* multirate=new DSPFILTERS::Templates::Halfband::Multirate<>;
+                        multirate->setup(filterMultirate,isBandLimited(),multirateAttenuation,multirateTransition);
+                        multirateArray.add(multirate);
+                    }
+                }
+            }
+            else if(!multirateArray.isEmpty())
+            {
+                multirateArray.clear();
+            }
+            
+            /* parallel forms follow the channels */
+            if(filterParallelForm)
+            {
+                if(parallelArray.size()!=numChannels)
+                {
+                    parallelArray.clear();
+                    
+                    for(int channel=0;channel<numChannels;++channel)
+                    {
+                        parallelArray.add(new DSPFILTERS::Templates::ParallelForm::Stages<Order>);
+                    }
+                }
+            }
+            else if(!parallelArray.isEmpty())
+            {
+                parallelArray.clear();
+            }
         }
         
         //
@@ -513,7 +940,7 @@ namespace Wrappers
         }
         
         //
-        //  FILTER PROCESS for an entire AudioSampleBuffer in one go.
+        //  FILTER PROCESS for an entire buffer in one go.
         //
         //  Uses current filter settings of Skeleton class, so make sure they're
         //  correctly set before calling this.
@@ -524,11 +951,86 @@ namespace Wrappers
         //  The filter wrappers will publish simplified abstractions of this one,
         //  always expecting the correct set of arguments for their filter kind.
         //
-        virtual void process (AudioSampleBuffer* stream)
+        virtual void process (ChannelSpan stream)
+        {
+            if(stream.isDouble()) {processSamples(stream.getChannels<double>(),stream.getChannels<double>(),stream.getNumChannels(),stream.getNumSamples(),0,0);}
+            else                  {processSamples(stream.getChannels<float>(),stream.getChannels<float>(),stream.getNumChannels(),stream.getNumSamples(),0,0);}
+        }
+        
+        //
+        //  OUT OF PLACE FILTER PROCESS, reads one buffer and writes the result into another.
+        //
+        //  Same as copying input into output and filtering that in place, only without
+        //  the copy. The filters read straight from input, so the dry signal stays
+        //  untouched for parallel processing, analysis and such.
+        //
+        //  Both need the same number of channels and samples, and the same sample type.
+        //  The ranged ones take numChannels channels from inputChannel on and write them
+        //  to the channels from outputChannel on, starting at inputSample and outputSample.
+        //  The filter states go by the channel in the range, so keep the ranges the same size.
+        //
+        //  Input and output may be the same buffer, but then with the same ranges.
+        //
+        virtual void process (ChannelSpan input, ChannelSpan output)
         {
-            const int numChannels=stream->getNumChannels();
-            const int numSamples=stream->getNumSamples();
+            process(input,0,0,output,0,0,input.getNumChannels(),input.getNumSamples());
+        }
+        
+        virtual void process (ChannelSpan input, int inputChannel, int inputSample, ChannelSpan output, int outputChannel, int outputSample, int numChannels, int numSamples)
+        {
+            jassert(input.isDouble()==output.isDouble());
+            jassert(inputChannel>=0 and inputChannel+numChannels<=input.getNumChannels());
+            jassert(outputChannel>=0 and outputChannel+numChannels<=output.getNumChannels());
+            jassert(inputSample>=0 and inputSample+numSamples<=input.getNumSamples());
+            jassert(outputSample>=0 and outputSample+numSamples<=output.getNumSamples());
+            
+            //  Mixed sample types can't be filtered into one another, leave output alone.
+            if(input.isDouble()!=output.isDouble())
+            {
+                return;
+            }
             
+            if(input.isDouble()) {processSamples(input.getChannels<double>()+inputChannel,output.getChannels<double>()+outputChannel,numChannels,numSamples,inputSample,outputSample);}
+            else                 {processSamples(input.getChannels<float>()+inputChannel,output.getChannels<float>()+outputChannel,numChannels,numSamples,inputSample,outputSample);}
+        }
+        
+        //  Raw pointer ones, input[channel]+inputSample goes to output[channel]+outputSample.
+        virtual void process (const float* const* input, float* const* output, int numChannels, int numSamples, int inputSample=0, int outputSample=0)
+        {
+            processSamples(input,output,numChannels,numSamples,inputSample,outputSample);
+        }
+        
+        virtual void process (const double* const* input, double* const* output, int numChannels, int numSamples, int inputSample=0, int outputSample=0)
+        {
+            processSamples(input,output,numChannels,numSamples,inputSample,outputSample);
+        }
+        
+#if DSPFILTERS_JUCE
+        template <typename Sample>
+        void process (const AudioBuffer<Sample>& input, AudioBuffer<Sample>& output)
+        {
+            jassert(input.getNumChannels()==output.getNumChannels());
+            jassert(input.getNumSamples()==output.getNumSamples());
+            
+            processSamples(input.getArrayOfReadPointers(),output.getArrayOfWritePointers(),input.getNumChannels(),input.getNumSamples(),0,0);
+        }
+        
+        template <typename Sample>
+        void process (const AudioBuffer<Sample>& input, int inputChannel, int inputSample, AudioBuffer<Sample>& output, int outputChannel, int outputSample, int numChannels, int numSamples)
+        {
+            jassert(inputChannel>=0 and inputChannel+numChannels<=input.getNumChannels());
+            jassert(outputChannel>=0 and outputChannel+numChannels<=output.getNumChannels());
+            jassert(inputSample>=0 and inputSample+numSamples<=input.getNumSamples());
+            jassert(outputSample>=0 and outputSample+numSamples<=output.getNumSamples());
+            
+            processSamples(input.getArrayOfReadPointers()+inputChannel,output.getArrayOfWritePointers()+outputChannel,numChannels,numSamples,inputSample,outputSample);
+        }
+#endif
+        
+        //  Every process() above ends up here, with floats or doubles.
+        template <typename Sample>
+        void processSamples (const Sample* const* input, Sample* const* output, int numChannels, int numSamples, int inputSample, int outputSample)
+        {
             prepareFilters(numChannels);
             
             jassert(filterSampleRate>0.0);
@@ -538,36 +1040,517 @@ namespace Wrappers
             
             for(int channel=0;channel<numChannels;++channel)
             {
-                float* channelData=stream->getWritePointer(channel);
+                processChannel(channel,input[channel]+inputSample,output[channel]+outputSample,numSamples);
+            }
+        }
+        
+        //
+        //  INTERLEAVED FILTER PROCESS, in place, for audio that isn't split into channels.
+        //
+        //  Hosts, sound cards and audio files often hand out frames with all channels
+        //  next to each other, L R L R... This filters them right where they are, no
+        //  splitting into one buffer per channel and back. The channels' states sit
+        //  next to each other the same way, so one SIMD register filters several
+        //  channels of a frame at once.
+        //
+        //  Keeps its own filter states, so consecutive calls continue seamlessly, but
+        //  don't mix with the regular process(). With the State Variable
+        //  filters, multirate or the parallel form, the frames go through the regular
+        //  channel filters instead, a few at a time.
+        //
+        //  Just like the regular process(), new settings reset the filter states.
+        //  There's no modulated version of this one, nothing glides in here.
+        //
+        virtual void process (float* interleaved, int numFrames, int numChannels)
+        {
+            processInterleaved(interleaved,numFrames,numChannels);
+        }
+        
+        virtual void process (double* interleaved, int numFrames, int numChannels)
+        {
+            processInterleaved(interleaved,numFrames,numChannels);
+        }
+        
+        template <typename Sample>
+        void processInterleaved (Sample* interleaved, int numFrames, int numChannels)
+        {
+            jassert(numChannels>0);
+            
+            if(Name!=DSPFILTERS::FilterNames::STATEVARIABLE and filterMultirate==1 and !filterParallelForm)
+            {
+                DSPFILTERS::Templates::Biquad stages[Order];
+                interleavedFilter.setup(stages,getStages(numChannels,stages));
+                interleavedFilter.process(numFrames,interleaved,numChannels);
+                return;
+            }
+            
+            prepareFilters(numChannels);
+            
+            const int tileFrames=64;
+            Sample tile[tileFrames];
+            
+            for(int start=0;start<numFrames;start+=tileFrames)
+            {
+                const int numSamples=jmin(tileFrames,numFrames-start);
+                Sample* frames=interleaved+start*numChannels;
                 
-                DSPFILTERS::Wrappers::Wrapper<Name,Type,Order>* channelFilter;
-                channelFilter=filterArray[channel];
+                for(int channel=0;channel<numChannels;++channel)
+                {
+                    for(int sample=0;sample<numSamples;++sample) {tile[sample]=frames[sample*numChannels+channel];}
+                    
+                    processChannel(channel,tile,tile,numSamples);
+                    
+                    for(int sample=0;sample<numSamples;++sample) {frames[sample*numChannels+channel]=tile[sample];}
+                }
+            }
+        }
+        
+        //
+        //  INTERLEAVED FILTER, the states of all channels for the interleaved process().
+        //
+        DSPFILTERS::Templates::Interleaved::Stages<Order> interleavedFilter;
+        
+        //  Filters one channel with its own filter, for the process() methods above.
+        //  Input and output may be the same.
+        template <typename Sample>
+        void processChannel (int channel, const Sample* input, Sample* output, int numSamples)
+        {
+            DSPFILTERS::Wrappers::Wrapper<Name,Type,Order>* channelFilter;
+            channelFilter=filterArray[channel];
+            
+            if(filterMultirate>1)
+            {
+                // Same as below, only that the filter sees one sample per frame
+                // and is set up for the lower sample rate.
+                const double lowSampleRate=filterSampleRate/filterMultirate;
+                
+                auto lowRateFilter=[&](double input)
+                {
+                    return channelFilter->processSample(input,
+                                                        lowSampleRate,
+                                                        filterFrequency,
+                                                        filterWidth,
+                                                        filterGain,
+                                                        filterRipple,
+                                                        filterRolloff);
+                };
                 
                 for(int sample=0;sample<numSamples;++sample)
                 {
-                    // This huge command doesn't care what the wrapped filter is.
-                    // It just shoves all the Skeleton filter properties into it
-                    // and the wrapped filter will update itself accordingly, as
-                    // well as find and use the parameters it needs by itself.
-                    channelData[sample]=channelFilter->processSample(channelData[sample],
-                                                                     filterSampleRate,
-                                                                     filterFrequency,
-                                                                     filterWidth,
-                                                                     filterGain,
-                                                                     filterRipple,
-                                                                     filterRolloff);
+                    output[sample]=multirateArray[channel]->process(input[sample],lowRateFilter);
+                }
+            }
+            else
+            {
+                // This huge command doesn't care what the wrapped filter is.
+                // It just shoves all the Skeleton filter properties into it
+                // and the wrapped filter will update itself accordingly, as
+                // well as find and use the parameters it needs by itself.
+                channelFilter->setup(filterSampleRate,
+                                     filterFrequency,
+                                     filterWidth,
+                                     filterGain,
+                                     filterRipple,
+                                     filterRolloff);
+                
+                // The parallel form takes over the freshly designed coefficients,
+                // if it can. Otherwise the whole channel goes through in one block.
+                DSPFILTERS::Templates::Biquad stages[Order];
+                
+                if(filterParallelForm and parallelArray[channel]->setup(stages,channelFilter->getStages(stages,Order)))
+                {
+                    // The parallel form only filters in place
+                    if(output!=input) {std::copy(input,input+numSamples,output);}
+                    
+                    parallelArray[channel]->process(numSamples,output);
+                }
+                else
+                {
+                    channelFilter->processBlock(input,output,numSamples);
                 }
             }
         }
         
         //  Convenient one-liner that you'll never use, because it's protected and
         //  the filters will always offer you a fitting simplification of this.
-        virtual void process (AudioSampleBuffer* stream, double SR, double Hz, double Width, double dB, double Ripple__or__Stopband, double Rolloff)
+        virtual void process (ChannelSpan stream, double SR, double Hz, double Width, double dB, double Ripple__or__Stopband, double Rolloff)
         {
             setup(SR,Hz,Width,dB,Ripple__or__Stopband,Rolloff);
             process(stream);
         }
         
+        //
+        //  MODULATED FILTER PROCESS for an entire buffer in one go.
+        //
+        //  Instead of a single frequency, width and gain for the whole buffer,
+        //  this takes one value per sample from the modulation arrays. Hand it
+        //  an LFO, an envelope or any other audio rate signal. Each array must
+        //  hold at least stream.getNumSamples() values, in Hz, Hz (or Q) and
+        //  dB respectively. Pass nullptr for any parameter that shouldn't be
+        //  modulated, then the current filter setting is used for it.
+        //
+        //  Unlike calling process() with new settings for every sample, this
+        //  doesn't redesign and reset the filters all the time. The filters
+        //  are only redesigned every getControlRate() samples, and between
+        //  two designs the coefficients glide smoothly from one to the next.
+        //
+        //  The modulation values are NOT stored as the filter's settings. If
+        //  you go back to the regular process() afterwards, the filters will
+        //  jump back to the settings you made with setup() or the setters.
+        //
+        //  Doesn't work with multirate, see setMultirate().
+        //
+        virtual void process (ChannelSpan stream, const float* cutoffModulation, const float* widthModulation, const float* gainModulation)
+        {
+            if(stream.isDouble()) {processModulated(stream.getChannels<double>(),stream.getNumChannels(),stream.getNumSamples(),cutoffModulation,widthModulation,gainModulation);}
+            else                  {processModulated(stream.getChannels<float>(),stream.getNumChannels(),stream.getNumSamples(),cutoffModulation,widthModulation,gainModulation);}
+        }
+        
+        template <typename Sample>
+        void processModulated (Sample* const* channels, int numChannels, int numSamples, const float* cutoffModulation, const float* widthModulation, const float* gainModulation)
+        {
+            prepareFilters(numChannels);
+            
+            jassert(filterMultirate==1);
+            jassert(filterSampleRate>0.0);
+            jassert(filterFrequency>0.0 or cutoffModulation!=nullptr);
+            jassert(!filterArray.isEmpty());
+            jassert(filterArray.size()==numChannels);
+            
+            for(int channel=0;channel<numChannels;++channel)
+            {
+                Sample* channelData=channels[channel];
+                
+                DSPFILTERS::Wrappers::Wrapper<Name,Type,Order>* channelFilter;
+                channelFilter=filterArray[channel];
+                
+                for(int start=0;start<numSamples;start+=filterControlRate)
+                {
+                    const int length=jmin(filterControlRate,numSamples-start);
+                    
+                    // Each control period heads for the values at its last sample,
+                    // that way the glide lands right on them when the period ends.
+                    const int target=start+length-1;
+                    
+                    channelFilter->modulate(filterSampleRate,
+                                            (cutoffModulation!=nullptr) ? cutoffModulation[target] : filterFrequency,
+                                            (widthModulation!=nullptr)  ? widthModulation[target]  : filterWidth,
+                                            (gainModulation!=nullptr)   ? gainModulation[target]   : filterGain,
+                                            filterRipple,
+                                            filterRolloff,
+                                            length);
+                    
+                    for(int sample=start;sample<start+length;++sample)
+                    {
+                        channelData[sample]=(Sample)channelFilter->processSample(channelData[sample]);
+                    }
+                }
+            }
+        }
+        
+        //
+        //  MULTI OUTPUT FILTER PROCESS for an entire buffer in one go.
+        //
+        //  Only the State Variable filters have this. Leaves the input stream
+        //  alone and writes the low pass, band pass and high pass outputs into
+        //  the other three buffers, which need to have as many channels and
+        //  samples as the input. Pass nullptr for outputs you don't need.
+        //
+        //  It's fine to pass the input stream as one of the outputs. All of them need
+        //  to have the same sample type, floats or doubles. Doesn't work with
+        //  multirate, see setMultirate().
+        //
+        void processMultiOutput (ChannelSpan stream, ChannelSpan low, ChannelSpan band, ChannelSpan high)
+        {
+            if(stream.isDouble()) {processMultiOutput<double>(stream,low,band,high);}
+            else                  {processMultiOutput<float>(stream,low,band,high);}
+        }
+        
+        template <typename Sample>
+        void processMultiOutput (ChannelSpan stream, ChannelSpan low, ChannelSpan band, ChannelSpan high)
+        {
+            const int numChannels=stream.getNumChannels();
+            const int numSamples=stream.getNumSamples();
+            
+            prepareFilters(numChannels);
+            
+            jassert(Name==DSPFILTERS::FilterNames::STATEVARIABLE);
+            jassert(filterMultirate==1);
+            jassert(filterSampleRate>0.0);
+            jassert(filterFrequency>0.0);
+            jassert(!filterArray.isEmpty());
+            jassert(filterArray.size()==numChannels);
+            jassert(low.isNull() or (low.isDouble()==stream.isDouble() and low.getNumChannels()==numChannels and low.getNumSamples()==numSamples));
+            jassert(band.isNull() or (band.isDouble()==stream.isDouble() and band.getNumChannels()==numChannels and band.getNumSamples()==numSamples));
+            jassert(high.isNull() or (high.isDouble()==stream.isDouble() and high.getNumChannels()==numChannels and high.getNumSamples()==numSamples));
+            
+            Sample* const* inputChannels=stream.getChannels<Sample>();
+            Sample* const* lowChannels =(!low.isNull())  ? low.getChannels<Sample>()  : nullptr;
+            Sample* const* bandChannels=(!band.isNull()) ? band.getChannels<Sample>() : nullptr;
+            Sample* const* highChannels=(!high.isNull()) ? high.getChannels<Sample>() : nullptr;
+            
+            //  An output of the other sample type can't be written, leave them all alone
+            if(inputChannels==nullptr or (!low.isNull() and lowChannels==nullptr) or (!band.isNull() and bandChannels==nullptr) or (!high.isNull() and highChannels==nullptr))
+            {
+                return;
+            }
+            
+            for(int channel=0;channel<numChannels;++channel)
+            {
+                const Sample* inputData=inputChannels[channel];
+                Sample* lowData =(lowChannels!=nullptr)  ? lowChannels[channel]  : nullptr;
+                Sample* bandData=(bandChannels!=nullptr) ? bandChannels[channel] : nullptr;
+                Sample* highData=(highChannels!=nullptr) ? highChannels[channel] : nullptr;
+                
+                DSPFILTERS::Wrappers::Wrapper<Name,Type,Order>* channelFilter;
+                channelFilter=filterArray[channel];
+                
+                channelFilter->setup(filterSampleRate,filterFrequency,filterWidth,filterGain,filterRipple,filterRolloff);
+                
+                for(int sample=0;sample<numSamples;++sample)
+                {
+                    double lowSample,bandSample,highSample;
+                    
+                    channelFilter->processSample(inputData[sample],lowSample,bandSample,highSample);
+                    
+                    if(lowData!=nullptr)    {lowData[sample]=(Sample)lowSample;}
+                    if(bandData!=nullptr)   {bandData[sample]=(Sample)bandSample;}
+                    if(highData!=nullptr)   {highData[sample]=(Sample)highSample;}
+                }
+            }
+        }
+        
+        //
+        //  ZERO PHASE FILTER PROCESS for offline use, like mastering or analysis.
+        //
+        //  Runs the filter over the whole stream forward and then backward. The
+        //  phase shifts of both passes cancel out, and the magnitude response is
+        //  applied twice. So a 4th order low pass turns into an 8th order one,
+        //  with -6 dB at the cutoff frequency instead of -3 dB.
+        //
+        //  Both ends are padded and the filter starts out in its steady state,
+        //  so there are no clicks or transients at the edges. This works right
+        //  in the buffer without copying or reversing it, and the channels are
+        //  spread over the cores, see setZeroPhaseThreads().
+        //
+        //  Not for processBlock(), the backward pass needs the ENTIRE signal.
+        //  The State Variable filters aren't made of biquads and can't do this.
+        //
+        void processZeroPhase (ChannelSpan stream)
+        {
+            if(stream.isDouble()) {processZeroPhase(stream.getChannels<double>(),stream.getNumChannels(),stream.getNumSamples());}
+            else                  {processZeroPhase(stream.getChannels<float>(),stream.getNumChannels(),stream.getNumSamples());}
+        }
+        
+        template <typename Sample>
+        void processZeroPhase (Sample* const* channelData, int numChannels, int numSamples)
+        {
+            DSPFILTERS::Templates::Biquad stages[Order];
+            const int numStages=getStages(numChannels,stages);
+            
+            processChannels(numChannels,[&](int channel)
+            {
+                DSPFILTERS::Templates::FiltFilt::Offline<Order> zeroPhase;
+                zeroPhase.setup(stages,numStages);
+                zeroPhase.process(numSamples,channelData[channel]);
+            });
+        }
+        
+        //
+        //  CHUNKED ZERO PHASE FILTER PROCESS for files that don't fit in memory.
+        //
+        //  Feed the file through processZeroPhaseChunk() piece by piece, in any
+        //  chunk sizes you like. The output is delayed by getZeroPhaseLatency()
+        //  samples, the first ones come out as silence. After the last chunk,
+        //  call flushZeroPhase() with a buffer of at least getZeroPhaseLatency()
+        //  samples, it writes out the rest and returns how many samples that is.
+        //  Then the next chunk starts a new file.
+        //
+        //  Memory stays the same no matter how long the file is. The backward
+        //  pass goes over blocks of setZeroPhaseBlockLength() samples, plus as
+        //  many samples as the filter needs to ring out, which is longer the
+        //  lower the filter frequency. Results match processZeroPhase() down
+        //  to about -150 dB.
+        //
+        void setZeroPhaseBlockLength (int samples) {jassert(samples>0);zeroPhaseBlockLength=jmax(1,samples);zeroPhaseArray.clear();}
+        int  getZeroPhaseBlockLength ()            {return zeroPhaseBlockLength;}
+        
+        //
+        //  The zero phase routines share their channels out to worker threads that
+        //  stay around until the filter is deleted, so chunk after chunk doesn't
+        //  start new threads. This starts them, call it before the first chunk.
+        //  Pass 0 threads to use all cores, 1 does everything on the calling thread.
+        //  If this isn't called, the first zero phase call starts all cores' worth.
+        //
+        void setZeroPhaseThreads (int numThreads=0) {channelWorkers.start(numThreads);}
+        int  getZeroPhaseThreads ()                 {return channelWorkers.getNumThreads();}
+        
+        int getZeroPhaseLatency ()
+        {
+            if(zeroPhaseArray.isEmpty())
+            {
+                DSPFILTERS::Templates::Biquad stages[Order];
+                
+                DSPFILTERS::Templates::FiltFilt::Streaming<Order> zeroPhase;
+                zeroPhase.setup(stages,getStages(1,stages));
+                zeroPhase.prepare(zeroPhaseBlockLength);
+                return zeroPhase.getLatency();
+            }
+            
+            return zeroPhaseArray[0]->getLatency();
+        }
+        
+        void processZeroPhaseChunk (ChannelSpan stream)
+        {
+            if(stream.isDouble()) {processZeroPhaseChunk(stream.getChannels<double>(),stream.getNumChannels(),stream.getNumSamples());}
+            else                  {processZeroPhaseChunk(stream.getChannels<float>(),stream.getNumChannels(),stream.getNumSamples());}
+        }
+        
+        template <typename Sample>
+        void processZeroPhaseChunk (Sample* const* channelData, int numChannels, int numSamples)
+        {
+            if(zeroPhaseArray.size()!=numChannels)
+            {
+                DSPFILTERS::Templates::Biquad stages[Order];
+                const int numStages=getStages(numChannels,stages);
+                
+                zeroPhaseArray.clear();
+                
+                for(int channel=0;channel<numChannels;++channel)
+                {
+                    DSPFILTERS::Templates::FiltFilt::Streaming<Order>* zeroPhase=new DSPFILTERS::Templates::FiltFilt::Streaming<Order>;
+                    zeroPhase->setup(stages,numStages);
+                    zeroPhase->prepare(zeroPhaseBlockLength);
+                    zeroPhaseArray.add(zeroPhase);
+                }
+            }
+            
+            processChannels(numChannels,[&](int channel)
+            {
+                zeroPhaseArray[channel]->process(numSamples,channelData[channel]);
+            });
+        }
+        
+        int flushZeroPhase (ChannelSpan stream)
+        {
+            if(stream.isDouble()) {return flushZeroPhase(stream.getChannels<double>(),stream.getNumChannels(),stream.getNumSamples());}
+            else                  {return flushZeroPhase(stream.getChannels<float>(),stream.getNumChannels(),stream.getNumSamples());}
+        }
+        
+        template <typename Sample>
+        int flushZeroPhase (Sample* const* channelData, int numChannels, int numSamples)
+        {
+            if(zeroPhaseArray.isEmpty())
+            {
+                return 0;
+            }
+            
+            jassert(numChannels==zeroPhaseArray.size());
+            jassert(numSamples>=zeroPhaseArray[0]->getLatency());
+            
+            std::vector<int> written((size_t)zeroPhaseArray.size(),0);
+            
+            processChannels(zeroPhaseArray.size(),[&](int channel)
+            {
+                written[(size_t)channel]=zeroPhaseArray[channel]->flush(channelData[channel]);
+            });
+            
+            zeroPhaseArray.clear();
+            
+            return written[0];
+        }
+        
+        //
+        //  ZERO PHASE ARRAY with one chunked engine per channel,
+        //  only populated between the first chunk and the flush.
+        //
+        FilterArray<DSPFILTERS::Templates::FiltFilt::Streaming<Order>> zeroPhaseArray;
+        
+        int zeroPhaseBlockLength=65536; // in samples
+        
+        //
+        //  TIME PARALLEL FILTER PROCESS for rendering long files offline.
+        //
+        //  Does exactly what process() does, but cuts every channel into as many
+        //  segments as there are cores and filters them all at the same time.
+        //  The segments are stitched together with the maths, not crossfades,
+        //  so the result is the same as with process(), down to rounding.
+        //
+        //  Each core does twice the work, so this pays off from 3 cores up, and
+        //  only for buffers of a few hundred thousand samples or more. Shorter
+        //  ones are simply filtered in one go. Keeps its own filter states, so
+        //  consecutive calls continue seamlessly, but don't mix with process().
+        //
+        //  Pass 0 threads to use all cores. Not for the State Variable filters.
+        //
+        void processTimeParallel (ChannelSpan stream, int numThreads=0)
+        {
+            if(stream.isDouble()) {processTimeParallel(stream.getChannels<double>(),stream.getNumChannels(),stream.getNumSamples(),numThreads);}
+            else                  {processTimeParallel(stream.getChannels<float>(),stream.getNumChannels(),stream.getNumSamples(),numThreads);}
+        }
+        
+        template <typename Sample>
+        void processTimeParallel (Sample* const* channelData, int numChannels, int numSamples, int numThreads)
+        {
+            DSPFILTERS::Templates::Biquad stages[Order];
+            const int numStages=getStages(numChannels,stages);
+            
+            if(timeParallelArray.size()!=numChannels)
+            {
+                timeParallelArray.clear();
+                
+                for(int channel=0;channel<numChannels;++channel)
+                {
+                    timeParallelArray.add(new DSPFILTERS::Templates::TimeParallel::Offline<Order>);
+                }
+            }
+            
+            for(int channel=0;channel<numChannels;++channel)
+            {
+                timeParallelArray[channel]->setup(stages,numStages);
+                timeParallelArray[channel]->process(numSamples,channelData[channel],numThreads);
+            }
+        }
+        
+        //
+        //  TIME PARALLEL ARRAY with one engine per channel, these
+        //  hold the states in between processTimeParallel() calls.
+        //
+        FilterArray<DSPFILTERS::Templates::TimeParallel::Offline<Order>> timeParallelArray;
+        
+        //  Sets up the first channel filter and grabs its coefficients.
+        //  Leaves a filter array that's already there alone, resizing it would
+        //  wipe the states process() runs on. Only channel 0 is needed anyway.
+        int getStages (int numChannels, DSPFILTERS::Templates::Biquad* stages)
+        {
+            if(filterArray.isEmpty())
+            {
+                prepareFilters(jmax(1,numChannels));
+            }
+            
+            jassert(Name!=DSPFILTERS::FilterNames::STATEVARIABLE);
+            
+            filterArray[0]->setup(filterSampleRate,filterFrequency,filterWidth,filterGain,filterRipple,filterRolloff);
+            return filterArray[0]->getStages(stages,Order);
+        }
+        
+        //
+        //  Runs function(channel) for every channel, spread over the channel workers.
+        //  Strictly for the offline stuff, the workers wake up for every call.
+        //
+        template <typename Function>
+        void processChannels (int numChannels, Function function)
+        {
+            if(!channelWorkers.isStarted())
+            {
+                channelWorkers.start(0);
+            }
+            
+            channelWorkers.run(numChannels,function);
+        }
+        
+        ChannelWorkers channelWorkers;
+        
     }; // end class Skeleton
     
 } // end namespace Wrappers
@@ -51,6 +51,27 @@
 /// can use within the DSPFILTERS (or altered) namespace.
 //
 
+//
+//  JUCE OR NOT
+//
+//  The wrappers only ever see raw channel pointers, see ChannelSpan.h. The
+//  AudioSampleBuffer routines on top of them are compiled in if JUCE's audio
+//  basics have been included before this file. Define DSPFILTERS_JUCE as 0 or
+//  1 before including DSPFilters.h to decide for yourself.
+//
+#ifndef DSPFILTERS_JUCE
+ #ifdef JUCE_AUDIO_BASICS_H_INCLUDED
+  #define DSPFILTERS_JUCE 1
+ #else
+  #define DSPFILTERS_JUCE 0
+ #endif
+#endif
+
+#if ! DSPFILTERS_JUCE && ! defined (jassert)
+ #define jassert(expression) assert(expression)
+ #define jassertfalse assert(false)
+#endif
+
 namespace DSPFILTERS
 {
 //
@@ -67,7 +88,8 @@ namespace DSPFILTERS
         CUSTOM,
         ELLIPTIC,
         LEGENDRE,
-        COOKBOOK /* to avoid RBJ redefinition */
+        COOKBOOK, /* to avoid RBJ redefinition */
+        STATEVARIABLE
     };
     
     enum FilterTypes
@@ -82,9 +104,34 @@ namespace DSPFILTERS
         HIGHSHELF,
         BANDSHELF
     };
+    
+#if ! DSPFILTERS_JUCE
+//
+//  Stand-ins for the JUCE helpers the wrappers use.
+//
+    template <typename Type> Type jmax (Type a, Type b) {return (a<b) ? b : a;}
+    template <typename Type> Type jmin (Type a, Type b) {return (b<a) ? b : a;}
+#endif
   
 /* ---------------- START INCLUDING ---------------- */
     
+//
+//  The JUCE-free building blocks all the wrappers below use. A span of
+//  channels to process, an array to keep one filter per channel in, and
+//  the threads the offline routines spread their channels over.
+//
+#ifndef WRAPPER_CHANNELSPAN_H_INCLUDED
+#include "ChannelSpan.h"
+#endif
+    
+#ifndef WRAPPER_FILTERARRAY_H_INCLUDED
+#include "FilterArray.h"
+#endif
+    
+#ifndef WRAPPER_CHANNELWORKERS_H_INCLUDED
+#include "ChannelWorkers.h"
+#endif
+    
 //
 //  This is not a real wrapper class, it just adds a fake "order" to
 //  RBJ Biquads that they otherwise wouldn't have.
@@ -96,7 +143,7 @@ namespace DSPFILTERS
 //
 //  This is the file that contains the definitions for the two major
 //  wrapper classes. DSPFilters to single channel abstract and single
-//  channel abstract to AudioSampleBuffer processor.
+//  channel abstract to multichannel buffer processor.
 //
 #ifndef WRAPPER_H_INCLUDED
 #include "Wrappers.h"
@@ -133,6 +180,25 @@ namespace DSPFILTERS
 #ifndef WRAPPER_RBJ_H_INCLUDED
 #include "RBJ.h"
 #endif
+    
+#ifndef WRAPPER_STATEVARIABLE_H_INCLUDED
+#include "StateVariable.h"
+#endif
+    
+//
+//  Not a filter, but a band splitter built from the
+//  Butterworth designs. Doesn't need the Skeleton.
+//
+#ifndef WRAPPER_CROSSOVER_H_INCLUDED
+#include "Crossover.h"
+#endif
+    
+//
+//  Halfband up- and downsampling for nonlinear processing.
+//
+#ifndef WRAPPER_OVERSAMPLING_H_INCLUDED
+#include "Oversampling.h"
+#endif
 
         
 /* --------------- END OF INCLUSIONS --------------- */
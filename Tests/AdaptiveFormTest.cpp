@@ -0,0 +1,85 @@
+//
+//  ADAPTIVE FORM TEST
+//  ==================
+//
+//  The block and time parallel engines hand the states of AdaptiveForm
+//  around through get/setValues(), which are those of the form it picked
+//  for the coefficients. Both have to match plain filter(), also when a
+//  change of coefficients between blocks moves a stage into another form.
+//
+//  Stages that run in float only match to the precision of float, so the
+//  difference is taken relative to the peak, against the target SNR.
+//
+
+#include "Check.h"
+
+namespace
+{
+    const int    numSamples=8192;
+    const double sampleRate=48000.0;
+    
+    //  Filters noise in chunks of chunkSize, the first half at cutoff and the second half at nextCutoff.
+    template <class Filter, class Process>
+    std::vector<double> run (Filter& filter, int chunkSize, double cutoff, double nextCutoff, Process process)
+    {
+        std::vector<double> samples=Check::noise<double>(numSamples);
+        
+        for(int start=0;start<numSamples;start+=chunkSize)
+        {
+            filter.setup(4,sampleRate,(start<numSamples/2) ? cutoff : nextCutoff);
+            process(std::min(chunkSize,numSamples-start),&samples[(size_t)start]);
+        }
+        
+        return samples;
+    }
+    
+    template <int TargetDb>
+    void check (bool timeParallelEngine, int chunkSize, double cutoff, double nextCutoff)
+    {
+        typedef DSP::Templates::AdaptiveForm<TargetDb> StateType;
+        typedef DSP::Templates::Butterworth::LowPass<4,StateType> Filter;
+        
+        Filter reference;
+        const std::vector<double> expected=run(reference,chunkSize,cutoff,nextCutoff,[&](int n, double* data)
+        {
+            for(int sample=0;sample<n;++sample) {data[sample]=reference.filter(data[sample]);}
+        });
+        
+        Filter filter;
+        DSP::Templates::TimeParallel::Offline<2,StateType> timeParallel;
+        timeParallel.setMinSegmentLength(256);
+        
+        const std::vector<double> actual=run(filter,chunkSize,cutoff,nextCutoff,[&](int n, double* data)
+        {
+            if(timeParallelEngine) {timeParallel.setup(filter); timeParallel.process(n,data,4);}
+            else                   {filter.filterBlock(n,data);}
+        });
+        
+        const double difference=Check::maxDifference(actual,expected)/Check::peak(expected);
+        const double tolerance=std::pow(10.0,-(TargetDb-20)/20.0);
+        
+        char what[128];
+        std::snprintf(what,sizeof(what),"AdaptiveForm<%d> %s matches filter, %g Hz to %g Hz",TargetDb,timeParallelEngine ? "TimeParallel" : "filterBlock",cutoff,nextCutoff);
+        Check::expect(difference<tolerance,what,difference);
+    }
+    
+    template <int TargetDb>
+    void check ()
+    {
+        check<TargetDb>(false,500,1000.0,1000.0);
+        check<TargetDb>(false,500,20.0,20.0);
+        check<TargetDb>(false,500,1000.0,2000.0);
+        
+        // TimeParallel resets when the coefficients change
+        check<TargetDb>(true,numSamples,1000.0,1000.0);
+        check<TargetDb>(true,numSamples,20.0,20.0);
+    }
+}
+
+int main ()
+{
+    check<60>();
+    check<120>();
+    
+    return Check::result();
+}
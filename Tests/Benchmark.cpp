@@ -0,0 +1,100 @@
+//
+//  BENCHMARK
+//  =========
+//
+//  Times the cascade kernels against plain filter() on every sample, for
+//  a few Butterworth low pass orders and block sizes, in ns per sample.
+//  All of them filter the same noise in double, Direct Form II states.
+//
+//    filter      CascadeStages::filter() sample by sample
+//    pipelined   filterPipelined(), see Pipeline.h
+//    unrolled    filterUnrolled(), see Unrolled.h
+//    structured  filterStructured(), see StructuredKernel.h
+//    block       filterBlock(), see BlockKernel.h, at the given tile size
+//
+//  Not a test, the numbers depend on the machine. Build in Release and run
+//  DSPFiltersBenchmark, optionally with the tile size for the block kernel.
+//
+
+#include "Check.h"
+
+#include <chrono>
+#include <cstdlib>
+
+namespace
+{
+    const int totalSamples=1<<21;
+    
+    //  Runs process(block) over totalSamples in blocks of blockSize, returns ns per sample.
+    template <class Process>
+    double time (int blockSize, std::vector<double>& buffer, Process process)
+    {
+        const std::vector<double> input=Check::noise<double>(blockSize);
+        
+        double best=1e30;
+        
+        // best of three, the first run also warms up the caches
+        for(int run=0;run<3;++run)
+        {
+            const auto start=std::chrono::steady_clock::now();
+            
+            for(int done=0;done<totalSamples;done+=blockSize)
+            {
+                std::copy(input.begin(),input.end(),buffer.begin());
+                process(blockSize,buffer.data());
+            }
+            
+            const auto stop=std::chrono::steady_clock::now();
+            best=std::min(best,std::chrono::duration<double,std::nano>(stop-start).count()/totalSamples);
+        }
+        
+        return best;
+    }
+    
+    template <int Order>
+    void run (int blockSize, int tileSize)
+    {
+        typedef DSP::Templates::Butterworth::LowPass<Order> Filter;
+        
+        Filter filter;
+        filter.setup(Order,48000.0,1000.0);
+        filter.setTileSize(tileSize);
+        
+        std::vector<double> buffer((size_t)blockSize);
+        
+        const double plain=time(blockSize,buffer,[&](int numSamples, double* data)
+        {
+            for(int sample=0;sample<numSamples;++sample) {data[sample]=filter.filter(data[sample]);}
+        });
+        
+        const double pipelined=time(blockSize,buffer,[&](int numSamples, double* data) {filter.filterPipelined(numSamples,data);});
+        const double unrolled =time(blockSize,buffer,[&](int numSamples, double* data) {filter.filterUnrolled(numSamples,data);});
+        const double structured=time(blockSize,buffer,[&](int numSamples, double* data) {filter.filterStructured(numSamples,data);});
+        const double block    =time(blockSize,buffer,[&](int numSamples, double* data) {filter.filterBlock(numSamples,data);});
+        
+        std::printf("%5d %6d %9.2f %10.2f %9.2f %11.2f %7.2f\n",Order,blockSize,plain,pipelined,unrolled,structured,block);
+    }
+    
+    template <int Order>
+    void runBlockSizes (int tileSize)
+    {
+        const int blockSizes[]={64,512,4096};
+        
+        for(int blockSize : blockSizes) {run<Order>(blockSize,tileSize);}
+    }
+}
+
+int main (int argc, char** argv)
+{
+    const int tileSize=(argc>1) ? std::max(1,std::atoi(argv[1])) : 128;
+    
+    std::printf("ns per sample, block kernel tile %d samples, SIMD level %d\n\n",tileSize,DSP::Templates::getSimdLevel());
+    std::printf("order  block    filter  pipelined  unrolled  structured   block\n");
+    
+    runBlockSizes<2>(tileSize);
+    runBlockSizes<4>(tileSize);
+    runBlockSizes<8>(tileSize);
+    runBlockSizes<16>(tileSize);
+    
+    return 0;
+}
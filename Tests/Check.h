@@ -0,0 +1,88 @@
+//
+//  CHECK
+//  =====
+//
+//  The few bits every test here shares. A test is a plain executable that
+//  prints what it checked and returns non-zero if anything failed, so CTest
+//  can run it without any test framework.
+//
+
+#ifndef DSPFILTERS_TESTS_CHECK_H_INCLUDED
+#define DSPFILTERS_TESTS_CHECK_H_INCLUDED
+
+#include "DSPFilters.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace Check
+{
+    static int failures=0;
+    
+    //  Counts and reports a failed check, returns the condition.
+    inline bool expect (bool condition, const char* what)
+    {
+        std::printf("%s  %s\n",condition ? "  ok" : "FAIL",what);
+        
+        if(!condition) {++failures;}
+        
+        return condition;
+    }
+    
+    //  Same, with the measured value next to it.
+    inline bool expect (bool condition, const char* what, double value)
+    {
+        std::printf("%s  %s (%g)\n",condition ? "  ok" : "FAIL",what,value);
+        
+        if(!condition) {++failures;}
+        
+        return condition;
+    }
+    
+    inline int result ()
+    {
+        std::printf("%d failed\n",failures);
+        return (failures==0) ? 0 : 1;
+    }
+    
+    //  Reproducible white noise in [-1,1), the same on every platform.
+    template <typename Sample>
+    std::vector<Sample> noise (int numSamples, unsigned int seed=1)
+    {
+        std::vector<Sample> samples((size_t)numSamples);
+        
+        for(Sample& sample : samples)
+        {
+            seed=seed*1664525u+1013904223u;
+            sample=(Sample)((int)(seed>>8)/8388608.0-1.0);
+        }
+        
+        return samples;
+    }
+    
+    template <typename Sample>
+    double maxDifference (const std::vector<Sample>& a, const std::vector<Sample>& b)
+    {
+        double difference=0.0;
+        
+        for(size_t sample=0;sample<a.size() and sample<b.size();++sample)
+        {
+            difference=std::max(difference,std::abs((double)a[sample]-(double)b[sample]));
+        }
+        
+        return difference;
+    }
+    
+    template <typename Sample>
+    double peak (const std::vector<Sample>& samples)
+    {
+        double level=0.0;
+        
+        for(Sample sample : samples) {level=std::max(level,std::abs((double)sample));}
+        
+        return level;
+    }
+}
+
+#endif // DSPFILTERS_TESTS_CHECK_H_INCLUDED
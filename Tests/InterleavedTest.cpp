@@ -0,0 +1,90 @@
+//
+//  INTERLEAVED TEST
+//  ================
+//
+//  The interleaved process() has to give the same result as the regular
+//  one on the same audio split into channels, also when the settings
+//  change between blocks. Both reset the filters on a change.
+//
+
+#include "Check.h"
+
+namespace
+{
+    const int    numChannels=3;
+    const int    numFrames=4096;
+    const int    blockSize=512;
+    const double sampleRate=48000.0;
+    
+    //  Runs the same noise through both, with a new cutoff for every block.
+    template <typename Sample, class Filter>
+    double compare (Filter& interleavedFilter, Filter& spanFilter)
+    {
+        std::vector<Sample> interleaved((size_t)(numFrames*numChannels));
+        std::vector<std::vector<Sample>> channels((size_t)numChannels,std::vector<Sample>((size_t)numFrames));
+        
+        for(int channel=0;channel<numChannels;++channel)
+        {
+            channels[(size_t)channel]=Check::noise<Sample>(numFrames,(unsigned int)channel+1);
+            
+            for(int frame=0;frame<numFrames;++frame) {interleaved[(size_t)(frame*numChannels+channel)]=channels[(size_t)channel][(size_t)frame];}
+        }
+        
+        for(int start=0;start<numFrames;start+=blockSize)
+        {
+            const double cutoff=500.0+start/2.0;
+            interleavedFilter.setFrequency(cutoff);
+            spanFilter.setFrequency(cutoff);
+            
+            Sample* pointers[numChannels];
+            for(int channel=0;channel<numChannels;++channel) {pointers[channel]=channels[(size_t)channel].data()+start;}
+            
+            interleavedFilter.process(interleaved.data()+start*numChannels,blockSize,numChannels);
+            spanFilter.process(DSP::ChannelSpan(pointers,numChannels,blockSize));
+        }
+        
+        double difference=0.0;
+        
+        for(int channel=0;channel<numChannels;++channel)
+        {
+            for(int frame=0;frame<numFrames;++frame)
+            {
+                difference=std::max(difference,std::abs((double)interleaved[(size_t)(frame*numChannels+channel)]-(double)channels[(size_t)channel][(size_t)frame]));
+            }
+        }
+        
+        return difference;
+    }
+    
+    template <typename Sample>
+    void check ()
+    {
+        const char* type=(sizeof(Sample)==8) ? "double" : "float";
+        const double tolerance=(sizeof(Sample)==8) ? 1e-12 : 1e-5;
+        char what[128];
+        
+        {
+            DSP::Butterworth<DSP::LOWPASS,4> a,b;
+            a.setup(sampleRate,1000.0); b.setup(sampleRate,1000.0);
+            std::snprintf(what,sizeof(what),"Butterworth interleaved matches channels, %s",type);
+            const double difference=compare<Sample>(a,b);
+            Check::expect(difference<tolerance,what,difference);
+        }
+        
+        {
+            DSP::RBJ<DSP::BANDPASS,2> a,b;
+            a.setup(sampleRate,1000.0,0.707,0.0); b.setup(sampleRate,1000.0,0.707,0.0);
+            std::snprintf(what,sizeof(what),"RBJ interleaved matches channels, %s",type);
+            const double difference=compare<Sample>(a,b);
+            Check::expect(difference<tolerance,what,difference);
+        }
+    }
+}
+
+int main ()
+{
+    check<float>();
+    check<double>();
+    
+    return Check::result();
+}
@@ -0,0 +1,76 @@
+//
+//  NOISE FLOOR TEST
+//  ================
+//
+//  Measures the noise floor of ErrorFeedbackDirectFormI against Direct Form I
+//  for a low pass far below the sample rate, where float states are at their
+//  worst. Every state filters the same float noise, the error is what is
+//  left after subtracting Direct Form I in double fed the same samples.
+//
+//    DirectFormI                  double states, float in and out
+//    ErrorFeedbackDirectFormI<0>  plain float states
+//    ErrorFeedbackDirectFormI<1>  first order error feedback
+//    ErrorFeedbackDirectFormI<2>  second order error feedback
+//
+
+#include "Check.h"
+
+namespace
+{
+    const int    numSamples=1<<16;
+    const double sampleRate=48000.0;
+    const double cutoff=20.0;
+    
+    template <class StateType, typename Sample>
+    std::vector<Sample> filter (const std::vector<float>& input)
+    {
+        DSP::Templates::Butterworth::LowPass<4,StateType> lowPass;
+        lowPass.setup(4,sampleRate,cutoff);
+        
+        std::vector<Sample> output(input.begin(),input.end());
+        
+        for(Sample& sample : output) {sample=lowPass.filter(sample);}
+        
+        return output;
+    }
+    
+    //  RMS of the difference to the reference in dB, over the second half so the start doesn't count.
+    double noiseFloor (const std::vector<float>& output, const std::vector<double>& reference)
+    {
+        double sum=0.0;
+        
+        for(size_t sample=output.size()/2;sample<output.size();++sample)
+        {
+            const double error=(double)output[sample]-reference[sample];
+            sum+=error*error;
+        }
+        
+        return 10.0*std::log10(sum/(output.size()/2)+1e-300);
+    }
+}
+
+int main ()
+{
+    using namespace DSP::Templates;
+    
+    const std::vector<float>  input=Check::noise<float>(numSamples);
+    const std::vector<double> reference=filter<DirectFormI,double>(input);
+    
+    const double directFormI=noiseFloor(filter<DirectFormI,float>(input),reference);
+    const double plainFloat =noiseFloor(filter<ErrorFeedbackDirectFormI<0>,float>(input),reference);
+    const double firstOrder =noiseFloor(filter<ErrorFeedbackDirectFormI<1>,float>(input),reference);
+    const double secondOrder=noiseFloor(filter<ErrorFeedbackDirectFormI<2>,float>(input),reference);
+    
+    std::printf("noise floor in dB, Butterworth low pass order 4 at %g Hz, %g Hz sample rate\n",cutoff,sampleRate);
+    std::printf("  DirectFormI                 %7.1f\n",directFormI);
+    std::printf("  ErrorFeedbackDirectFormI<0> %7.1f\n",plainFloat);
+    std::printf("  ErrorFeedbackDirectFormI<1> %7.1f\n",firstOrder);
+    std::printf("  ErrorFeedbackDirectFormI<2> %7.1f\n",secondOrder);
+    
+    Check::expect(secondOrder<firstOrder,"second order error feedback below first order",secondOrder-firstOrder);
+    Check::expect(firstOrder<plainFloat,"first order error feedback below plain float states",firstOrder-plainFloat);
+    Check::expect(secondOrder<plainFloat-30.0,"second order error feedback at least 30 dB below plain float states",secondOrder-plainFloat);
+    Check::expect(secondOrder<directFormI+3.0,"second order error feedback within 3 dB of DirectFormI",secondOrder-directFormI);
+    
+    return Check::result();
+}
@@ -0,0 +1,143 @@
+//
+//  SMOKE TEST
+//  ==========
+//
+//  Builds DSPFilters.h without JUCE and runs one low and one high pass of
+//  every filter family, plus the Crossover and the Oversampling, through
+//  a stereo ChannelSpan of DC. The low passes have to let it through and
+//  the high passes have to block it, in float and in double.
+//
+
+#include "Check.h"
+
+#if DSPFILTERS_JUCE
+ #error "The smoke test is meant to build without JUCE"
+#endif
+
+//  Feeds numSamples of DC through both channels, returns the last output sample.
+template <typename Sample, class Filter>
+double settle (Filter& filter, int numSamples=48000)
+{
+    std::vector<Sample> left((size_t)numSamples,(Sample)1);
+    std::vector<Sample> right((size_t)numSamples,(Sample)1);
+    
+    Sample* channels[2]={left.data(),right.data()};
+    filter.process(DSP::ChannelSpan(channels,2,numSamples));
+    
+    const double last=left.back();
+    return (std::isfinite(last) and left.back()==right.back()) ? last : NAN;
+}
+
+//  Low pass passes DC (gain set by the ripple for the Chebyshevs), high pass blocks it.
+template <typename Sample, class LowPass, class HighPass>
+void checkFamily (const char* name, LowPass& lowPass, HighPass& highPass, double lowGain=1.0)
+{
+    char what[128];
+    
+    const double low=settle<Sample>(lowPass);
+    std::snprintf(what,sizeof(what),"%s low pass, %s, passes DC",name,sizeof(Sample)==8 ? "double" : "float");
+    Check::expect(std::abs(low-lowGain)<1e-3,what,low);
+    
+    const double high=settle<Sample>(highPass);
+    std::snprintf(what,sizeof(what),"%s high pass, %s, blocks DC",name,sizeof(Sample)==8 ? "double" : "float");
+    Check::expect(std::abs(high)<1e-3,what,high);
+}
+
+template <typename Sample>
+void checkFamilies ()
+{
+    const double SR=48000.0;
+    
+    {DSP::Bessel<DSP::LOWPASS,4> lp; DSP::Bessel<DSP::HIGHPASS,4> hp;
+     lp.setup(SR,1000.0); hp.setup(SR,1000.0); checkFamily<Sample>("Bessel",lp,hp);}
+    
+    {DSP::Butterworth<DSP::LOWPASS,4> lp; DSP::Butterworth<DSP::HIGHPASS,4> hp;
+     lp.setup(SR,1000.0); hp.setup(SR,1000.0); checkFamily<Sample>("Butterworth",lp,hp);}
+    
+    // even order, so DC sits at the bottom of the 1 dB ripple
+    {DSP::ChebyshevI<DSP::LOWPASS,4> lp; DSP::ChebyshevI<DSP::HIGHPASS,4> hp;
+     lp.setup(SR,1000.0,0.0,0.0,1.0); hp.setup(SR,1000.0,0.0,0.0,1.0); checkFamily<Sample>("ChebyshevI",lp,hp,std::pow(10.0,-1.0/20.0));}
+    
+    {DSP::ChebyshevII<DSP::LOWPASS,4> lp; DSP::ChebyshevII<DSP::HIGHPASS,4> hp;
+     lp.setup(SR,1000.0,0.0,0.0,80.0); hp.setup(SR,1000.0,0.0,0.0,80.0); checkFamily<Sample>("ChebyshevII",lp,hp);}
+    
+    {DSP::Elliptic<DSP::LOWPASS,4> lp; DSP::Elliptic<DSP::HIGHPASS,4> hp;
+     lp.setup(SR,1000.0,1.0,1.0); hp.setup(SR,1000.0,1.0,1.0); checkFamily<Sample>("Elliptic",lp,hp,std::pow(10.0,-1.0/20.0));}
+    
+    {DSP::Legendre<DSP::LOWPASS,4> lp; DSP::Legendre<DSP::HIGHPASS,4> hp;
+     lp.setup(SR,1000.0); hp.setup(SR,1000.0); checkFamily<Sample>("Legendre",lp,hp);}
+    
+    {DSP::RBJ<DSP::LOWPASS,2> lp; DSP::RBJ<DSP::HIGHPASS,2> hp;
+     lp.setup(SR,1000.0,0.707,0.0); hp.setup(SR,1000.0,0.707,0.0); checkFamily<Sample>("RBJ",lp,hp);}
+    
+    {DSP::StateVariable<DSP::LOWPASS,2> lp; DSP::StateVariable<DSP::HIGHPASS,2> hp;
+     lp.setup(SR,1000.0); hp.setup(SR,1000.0); checkFamily<Sample>("StateVariable",lp,hp);}
+}
+
+template <typename Sample>
+void checkCrossover ()
+{
+    const int numSamples=48000;
+    const double splits[2]={300.0,3000.0};
+    
+    DSP::Crossover<3,4> crossover;
+    crossover.setup(48000.0,splits);
+    
+    std::vector<Sample> input((size_t)numSamples,(Sample)1);
+    std::vector<Sample> low((size_t)numSamples),mid((size_t)numSamples),high((size_t)numSamples);
+    
+    Sample* inputChannels[1]={input.data()};
+    Sample* lowChannels[1]={low.data()};
+    Sample* midChannels[1]={mid.data()};
+    Sample* highChannels[1]={high.data()};
+    
+    const DSP::ChannelSpan bands[3]={DSP::ChannelSpan(lowChannels,1,numSamples),
+                                     DSP::ChannelSpan(midChannels,1,numSamples),
+                                     DSP::ChannelSpan(highChannels,1,numSamples)};
+    
+    crossover.process(DSP::ChannelSpan(inputChannels,1,numSamples),bands);
+    
+    Check::expect(std::abs(low.back()-1.0)<1e-3 and std::abs(mid.back())<1e-3 and std::abs(high.back())<1e-3,
+                  sizeof(Sample)==8 ? "Crossover, double, puts DC into the low band" : "Crossover, float, puts DC into the low band",
+                  low.back());
+}
+
+template <typename Sample>
+void checkOversampling ()
+{
+    const int numSamples=4800;
+    const int factor=4;
+    
+    DSP::Oversampling<factor> oversampling;
+    oversampling.prepare(1,numSamples);
+    
+    std::vector<Sample> stream((size_t)numSamples,(Sample)1);
+    std::vector<Sample> oversampled((size_t)(numSamples*factor));
+    
+    Sample* streamChannels[1]={stream.data()};
+    Sample* oversampledChannels[1]={oversampled.data()};
+    
+    const DSP::ChannelSpan streamSpan(streamChannels,1,numSamples);
+    const DSP::ChannelSpan oversampledSpan(oversampledChannels,1,numSamples*factor);
+    
+    oversampling.upsample(streamSpan,oversampledSpan);
+    oversampling.downsample(streamSpan,oversampledSpan);
+    
+    Check::expect(std::abs(oversampled.back()-1.0)<1e-3 and std::abs(stream.back()-1.0)<1e-3,
+                  sizeof(Sample)==8 ? "Oversampling, double, keeps DC" : "Oversampling, float, keeps DC",
+                  stream.back());
+}
+
+int main ()
+{
+    checkFamilies<float>();
+    checkFamilies<double>();
+    
+    checkCrossover<float>();
+    checkCrossover<double>();
+    
+    checkOversampling<float>();
+    checkOversampling<double>();
+    
+    return Check::result();
+}
@@ -0,0 +1,62 @@
+//
+//  TIME PARALLEL TEST
+//  ==================
+//
+//  TimeParallel cuts the signal into segments and stitches them together
+//  with the state transition, so it has to match a serial filter() down to
+//  rounding. Short and uneven lengths with tiny segments are the tricky
+//  ones, the last segment ends up shorter than the others or not at all.
+//
+
+#include "Check.h"
+
+namespace
+{
+    typedef DSP::Templates::Butterworth::LowPass<4> Filter;
+    
+    //  Two calls of numSamples each, so the states have to carry over as well.
+    double compare (int numSamples, int numThreads, int minSegmentLength)
+    {
+        Filter serial;
+        serial.setup(4,48000.0,1000.0);
+        
+        DSP::Templates::TimeParallel::Offline<2> timeParallel;
+        timeParallel.setup(serial);
+        timeParallel.setMinSegmentLength(minSegmentLength);
+        
+        const std::vector<double> input=Check::noise<double>(2*numSamples);
+        std::vector<double> expected=input;
+        std::vector<double> actual=input;
+        
+        for(double& sample : expected) {sample=serial.filter(sample);}
+        
+        timeParallel.process(numSamples,actual.data(),numThreads);
+        timeParallel.process(numSamples,actual.data()+numSamples,numThreads);
+        
+        return Check::maxDifference(actual,expected)/std::max(1e-30,Check::peak(expected));
+    }
+}
+
+int main ()
+{
+    const int lengths[]={1,2,3,7,9,10,17,100,1001,4097};
+    const int threads[]={2,3,8};
+    const int minSegmentLengths[]={1,3,256};
+    
+    for(int numSamples : lengths)
+    {
+        for(int numThreads : threads)
+        {
+            for(int minSegmentLength : minSegmentLengths)
+            {
+                char what[128];
+                std::snprintf(what,sizeof(what),"TimeParallel matches filter, %d samples, %d threads, segments from %d",numSamples,numThreads,minSegmentLength);
+                
+                const double difference=compare(numSamples,numThreads,minSegmentLength);
+                Check::expect(difference<1e-9,what,difference);
+            }
+        }
+    }
+    
+    return Check::result();
+}
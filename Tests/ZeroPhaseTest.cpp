@@ -0,0 +1,56 @@
+//
+//  ZERO PHASE TEST
+//  ===============
+//
+//  The zero phase routines share the filter with the real-time process().
+//  Asking them for their latency mustn't touch the states process() runs
+//  on, so a filter that gets asked has to carry on just like one that doesn't.
+//
+
+#include "Check.h"
+
+namespace
+{
+    const int    numChannels=2;
+    const int    blockSize=4800;
+    const double sampleRate=48000.0;
+    
+    //  One block of noise through both channels, returns the filtered left one.
+    template <typename Sample, class Filter>
+    std::vector<Sample> processBlock (Filter& filter, unsigned int seed)
+    {
+        std::vector<Sample> left=Check::noise<Sample>(blockSize,seed);
+        std::vector<Sample> right=Check::noise<Sample>(blockSize,seed+1);
+        
+        Sample* channels[numChannels]={left.data(),right.data()};
+        filter.process(DSP::ChannelSpan(channels,numChannels,blockSize));
+        
+        return left;
+    }
+    
+    template <typename Sample>
+    void checkLatencyQuery ()
+    {
+        DSP::Butterworth<DSP::LOWPASS,4> asked,untouched;
+        asked.setup(sampleRate,100.0); untouched.setup(sampleRate,100.0);
+        
+        processBlock<Sample>(asked,1);
+        processBlock<Sample>(untouched,1);
+        
+        const int latency=asked.getZeroPhaseLatency();
+        
+        const double difference=Check::maxDifference(processBlock<Sample>(asked,3),processBlock<Sample>(untouched,3));
+        
+        char what[128];
+        std::snprintf(what,sizeof(what),"Zero phase latency query leaves process() alone, %s",(sizeof(Sample)==8) ? "double" : "float");
+        Check::expect(latency>0 and difference==0.0,what,difference);
+    }
+}
+
+int main ()
+{
+    checkLatencyQuery<float>();
+    checkLatencyQuery<double>();
+    
+    return Check::result();
+}